@@ -0,0 +1,193 @@
+// Compares batch encodes and decodes of many short items with calling Encode and Decode once per item
+// Throughput is counted in millions of items per second and GB/s of unencoded bytes
+// Usage: base64_batch_bench [--count items] [--size bytes]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../src/Base64Encoding.hpp"
+
+#define BENCHMARK_RUN_COUNT 3
+
+// Returns the shortest time, in seconds, of several runs of the given operation
+template<typename Operation>
+double MeasureSeconds(Operation operation)
+{
+    double bestSeconds = 0;
+
+    for(int run = 0; run < BENCHMARK_RUN_COUNT; run++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        operation();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if(run == 0 || elapsed.count() < bestSeconds)
+        {
+            bestSeconds = elapsed.count();
+        }
+    }
+
+    return bestSeconds;
+}
+
+const char* KernelName(Base64EncodingKernel kernel)
+{
+    switch(kernel)
+    {
+        case Base64EncodingKernel::Base64KernelSsse3:
+            return "ssse3";
+
+        case Base64EncodingKernel::Base64KernelAvx2:
+            return "avx2";
+
+        case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+            return "avx512vbmi";
+
+        default:
+            return "scalar";
+    }
+}
+
+void PrintResult(Base64EncodingKernel kernel, const char* pName, size_t itemCount, size_t itemLength, double seconds)
+{
+    printf("%-10s  %-28s  %10.2f  %8.2f\n", KernelName(kernel), pName, itemCount / seconds / 1e6, (double)itemCount * itemLength / seconds / 1e9);
+}
+
+int main(int argc, char** argv)
+{
+    size_t itemCount = 10000000;
+    size_t itemLength = 32;
+
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--count") == 0)
+        {
+            itemCount = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--size") == 0)
+        {
+            itemLength = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--count items] [--size bytes]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+    // Every item is a separate token within one large allocation
+    std::vector<uint8_t> input(itemCount * itemLength);
+    std::vector<Base64BatchItem> items(itemCount);
+
+    for(size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    for(size_t i = 0; i < itemCount; i++)
+    {
+        items[i] = { input.data() + i * itemLength, itemLength };
+    }
+
+    std::vector<char> encoded(base64.EncodedBatchLength(items.data(), itemCount));
+    std::vector<size_t> offsets(itemCount + 1);
+    std::vector<uint8_t> decoded(input.size());
+
+    printf("%zu items of %zu bytes\n", itemCount, itemLength);
+    printf("%-10s  %-28s  %10s  %8s\n", "kernel", "", "Mitems/s", "GB/s");
+
+    for(int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= Base64EncodingSimd::SupportedKernel(); kernel++)
+    {
+        base64.SetKernel((Base64EncodingKernel)kernel);
+
+        // The per item baseline constructs the encoding for every call, as a caller without a long lived instance would
+        double seconds = MeasureSeconds([&]
+        {
+            size_t offset = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                Base64Encoding itemBase64('+', '/', Base64EncodingOptions::Padded);
+
+                itemBase64.SetKernel((Base64EncodingKernel)kernel);
+
+                offsets[i] = offset;
+                offset += (size_t)itemBase64.Encode((const uint8_t*)items[i].pData, items[i].Length, encoded.data() + offset, encoded.size() - offset);
+            }
+
+            offsets[itemCount] = offset;
+        });
+
+        PrintResult((Base64EncodingKernel)kernel, "Encode, constructed per item", itemCount, itemLength, seconds);
+
+        seconds = MeasureSeconds([&]
+        {
+            size_t offset = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                offsets[i] = offset;
+                offset += (size_t)base64.Encode((const uint8_t*)items[i].pData, items[i].Length, encoded.data() + offset, encoded.size() - offset);
+            }
+
+            offsets[itemCount] = offset;
+        });
+
+        PrintResult((Base64EncodingKernel)kernel, "Encode in a loop", itemCount, itemLength, seconds);
+
+        std::vector<char> expected(encoded);
+
+        seconds = MeasureSeconds([&]
+        {
+            base64.EncodeBatch(items.data(), itemCount, encoded.data(), encoded.size(), offsets.data());
+        });
+
+        PrintResult((Base64EncodingKernel)kernel, "EncodeBatch", itemCount, itemLength, seconds);
+
+        // A fast but wrong batch is not a result
+        if(encoded != expected)
+        {
+            fprintf(stderr, "EncodeBatch output differs from Encode for the %s kernel\n", KernelName((Base64EncodingKernel)kernel));
+            return 1;
+        }
+
+        std::vector<Base64BatchItem> encodedItems(itemCount);
+
+        for(size_t i = 0; i < itemCount; i++)
+        {
+            encodedItems[i] = { encoded.data() + offsets[i], offsets[i + 1] - offsets[i] };
+        }
+
+        seconds = MeasureSeconds([&]
+        {
+            size_t offset = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                offset += (size_t)base64.Decode((const char*)encodedItems[i].pData, encodedItems[i].Length, decoded.data() + offset, decoded.size() - offset);
+            }
+        });
+
+        PrintResult((Base64EncodingKernel)kernel, "Decode in a loop", itemCount, itemLength, seconds);
+
+        seconds = MeasureSeconds([&]
+        {
+            base64.DecodeBatch(encodedItems.data(), itemCount, decoded.data(), decoded.size(), offsets.data());
+        });
+
+        PrintResult((Base64EncodingKernel)kernel, "DecodeBatch", itemCount, itemLength, seconds);
+
+        if(decoded != input)
+        {
+            fprintf(stderr, "DecodeBatch output differs from the input for the %s kernel\n", KernelName((Base64EncodingKernel)kernel));
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+// Measures encode and decode throughput for every input size, padding mode and supported kernel
+// Results are written as JSON, with throughput counted in GB/s of unencoded bytes, and a summary is printed to stderr
+// Usage: base64_bench [--min-size bytes] [--max-size bytes] [--alphabet standard|url|imap|bcrypt|crypt] [--output path]
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../src/Base64Encoding.hpp"
+
+// Each timed run repeats the operation until at least this many bytes are processed, so small inputs are not lost in timer resolution
+#define BENCHMARK_MINIMUM_RUN_BYTES (64 * 1024 * 1024)
+
+#define BENCHMARK_RUN_COUNT 3
+
+struct BenchmarkResult
+{
+    Base64EncodingKernel Kernel;
+    Base64EncodingOptions Options;
+    size_t InputLength;
+    double EncodeThroughput;
+    double DecodeThroughput;
+};
+
+const char* KernelName(Base64EncodingKernel kernel)
+{
+    switch(kernel)
+    {
+        case Base64EncodingKernel::Base64KernelSsse3:
+            return "ssse3";
+
+        case Base64EncodingKernel::Base64KernelAvx2:
+            return "avx2";
+
+        case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+            return "avx512vbmi";
+
+        default:
+            return "scalar";
+    }
+}
+
+// Returns the 64 characters of the named alphabet, or NULL if the name is not known
+const char* AlphabetCharacters(const char* pName)
+{
+    const char* alphabets[][2] =
+    {
+        { "standard", BASE64ENCODING_STANDARD_ALPHABET },
+        { "url", BASE64ENCODING_URL_SAFE_ALPHABET },
+        { "imap", BASE64ENCODING_IMAP_ALPHABET },
+        { "bcrypt", BASE64ENCODING_BCRYPT_ALPHABET },
+        { "crypt", BASE64ENCODING_CRYPT_ALPHABET }
+    };
+
+    for(const auto& alphabet : alphabets)
+    {
+        if(strcmp(pName, alphabet[0]) == 0)
+        {
+            return alphabet[1];
+        }
+    }
+
+    return NULL;
+}
+
+// Returns the best throughput, in GB/s, of several runs of the given operation over the given number of bytes
+template<typename Operation>
+double MeasureThroughput(size_t byteCount, Operation operation)
+{
+    size_t iterationCount = std::max((size_t)1, (size_t)BENCHMARK_MINIMUM_RUN_BYTES / byteCount);
+    double bestSeconds = 0;
+
+    for(int run = 0; run < BENCHMARK_RUN_COUNT; run++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        for(size_t iteration = 0; iteration < iterationCount; iteration++)
+        {
+            operation();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if(run == 0 || elapsed.count() < bestSeconds)
+        {
+            bestSeconds = elapsed.count();
+        }
+    }
+
+    return (double)byteCount * iterationCount / bestSeconds / 1e9;
+}
+
+void WriteJson(FILE* pFile, const char* pAlphabetName, const std::vector<BenchmarkResult>& results)
+{
+    fprintf(pFile, "{\n");
+    fprintf(pFile, "  \"supported_kernel\": \"%s\",\n", KernelName(Base64EncodingSimd::SupportedKernel()));
+    fprintf(pFile, "  \"alphabet\": \"%s\",\n", pAlphabetName);
+    fprintf(pFile, "  \"unit\": \"GB/s\",\n");
+    fprintf(pFile, "  \"results\": [\n");
+
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult& result = results[i];
+
+        fprintf(pFile, "    { \"kernel\": \"%s\", \"padding\": \"%s\", \"input_bytes\": %zu, \"encode\": %.4f, \"decode\": %.4f }%s\n",
+                KernelName(result.Kernel),
+                BIT_IS_SET(result.Options, Base64EncodingOptions::Padded) ? "padded" : "unpadded",
+                result.InputLength,
+                result.EncodeThroughput,
+                result.DecodeThroughput,
+                i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(pFile, "  ]\n");
+    fprintf(pFile, "}\n");
+}
+
+int main(int argc, char** argv)
+{
+    size_t minimumInputLength = 16;
+    size_t maximumInputLength = (size_t)1 << 30;
+    const char* pAlphabetName = "standard";
+    const char* pOutputPath = NULL;
+
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--min-size") == 0)
+        {
+            minimumInputLength = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--max-size") == 0)
+        {
+            maximumInputLength = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--alphabet") == 0 && AlphabetCharacters(argv[i + 1]) != NULL)
+        {
+            pAlphabetName = argv[i + 1];
+        }
+        else if(strcmp(argv[i], "--output") == 0)
+        {
+            pOutputPath = argv[i + 1];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--min-size bytes] [--max-size bytes] [--alphabet standard|url|imap|bcrypt|crypt] [--output path]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if(minimumInputLength == 0)
+    {
+        minimumInputLength = 1;
+    }
+
+    Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+    std::vector<BenchmarkResult> results;
+
+    fprintf(stderr, "%s alphabet\n", pAlphabetName);
+    fprintf(stderr, "kernel      padding   input bytes  encode GB/s  decode GB/s\n");
+
+    // Input sizes grow by a factor of four from the minimum to the maximum
+    for(size_t inputLength = minimumInputLength; inputLength <= maximumInputLength; inputLength *= 4)
+    {
+        std::vector<uint8_t> input(inputLength);
+        std::vector<uint8_t> decoded(inputLength);
+
+        for(size_t i = 0; i < inputLength; i++)
+        {
+            input[i] = (uint8_t)(i * 2654435761u >> 24);
+        }
+
+        for(Base64EncodingOptions option : options)
+        {
+            Base64Encoding base64(AlphabetCharacters(pAlphabetName), option);
+            std::vector<char> encoded(base64.EncodedLength(inputLength));
+
+            for(int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= Base64EncodingSimd::SupportedKernel(); kernel++)
+            {
+                base64.SetKernel((Base64EncodingKernel)kernel);
+
+                double encodeThroughput = MeasureThroughput(inputLength, [&]
+                {
+                    base64.Encode(input.data(), inputLength, encoded.data(), encoded.size());
+                });
+
+                double decodeThroughput = MeasureThroughput(inputLength, [&]
+                {
+                    base64.Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size());
+                });
+
+                // A fast but wrong kernel is not a result
+                if(memcmp(input.data(), decoded.data(), inputLength) != 0)
+                {
+                    fprintf(stderr, "Round trip failed for the %s kernel with %zu bytes\n", KernelName((Base64EncodingKernel)kernel), inputLength);
+                    return 1;
+                }
+
+                results.push_back({ (Base64EncodingKernel)kernel, option, inputLength, encodeThroughput, decodeThroughput });
+
+                fprintf(stderr, "%-10s  %-8s  %11zu  %11.2f  %11.2f\n",
+                        KernelName((Base64EncodingKernel)kernel),
+                        BIT_IS_SET(option, Base64EncodingOptions::Padded) ? "padded" : "unpadded",
+                        inputLength,
+                        encodeThroughput,
+                        decodeThroughput);
+            }
+        }
+
+        // Stop before the next size would overflow
+        if(inputLength > maximumInputLength / 4)
+        {
+            break;
+        }
+    }
+
+    FILE* pFile = pOutputPath != NULL ? fopen(pOutputPath, "w") : stdout;
+
+    if(pFile == NULL)
+    {
+        fprintf(stderr, "Could not open %s\n", pOutputPath);
+        return 1;
+    }
+
+    WriteJson(pFile, pAlphabetName, results);
+
+    if(pFile != stdout)
+    {
+        fclose(pFile);
+    }
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Compares decoding or encoding and then checksumming the binary data in a second pass with Base64ChecksumEncoding, which does both in one pass
+// Both CRC-32C and XXH64 are computed, and throughput is counted in GB/s of binary data
+// Usage: base64_checksum_bench [--size bytes]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../src/Base64EncodingChecksum.hpp"
+
+#define BENCHMARK_RUN_COUNT 5
+
+// Returns the shortest time, in seconds, of several runs of the given operation
+template<typename Operation>
+double MeasureSeconds(Operation operation)
+{
+    double bestSeconds = 0;
+
+    for(int run = 0; run < BENCHMARK_RUN_COUNT; run++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        operation();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if(run == 0 || elapsed.count() < bestSeconds)
+        {
+            bestSeconds = elapsed.count();
+        }
+    }
+
+    return bestSeconds;
+}
+
+void PrintResult(const char* pName, size_t length, double seconds)
+{
+    printf("%-36s  %8.2f\n", pName, (double)length / seconds / 1e9);
+}
+
+int main(int argc, char** argv)
+{
+    size_t length = 64 << 20;
+
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--size") == 0)
+        {
+            length = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--size bytes]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+    Base64ChecksumEncoding checksumBase64(base64);
+
+    std::vector<uint8_t> input(length);
+    std::vector<char> encoded(base64.EncodedLength(length));
+    std::vector<uint8_t> decoded(length);
+
+    for(size_t i = 0; i < length; i++)
+    {
+        input[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    base64.Encode(input.data(), length, encoded.data(), encoded.size());
+
+    uint32_t separateCrc = 0;
+    uint64_t separateHash = 0;
+    uint32_t fusedCrc = 0;
+    uint64_t fusedHash = 0;
+
+    printf("%zu bytes, CRC-32C and XXH64\n", length);
+    printf("%-36s  %8s\n", "", "GB/s");
+
+    double seconds = MeasureSeconds([&]
+    {
+        Base64Crc32c crc;
+        Base64XxHash64 hash;
+
+        base64.Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size());
+        crc.Update(decoded.data(), length);
+        hash.Update(decoded.data(), length);
+
+        separateCrc = crc.Digest();
+        separateHash = hash.Digest();
+    });
+
+    PrintResult("Decode, then checksum", length, seconds);
+
+    seconds = MeasureSeconds([&]
+    {
+        Base64Crc32c crc;
+        Base64XxHash64 hash;
+
+        checksumBase64.Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size(), crc, hash);
+
+        fusedCrc = crc.Digest();
+        fusedHash = hash.Digest();
+    });
+
+    PrintResult("Base64ChecksumEncoding::Decode", length, seconds);
+
+    // A fast but wrong checksum is not a result
+    if(fusedCrc != separateCrc || fusedHash != separateHash || decoded != input)
+    {
+        fprintf(stderr, "Base64ChecksumEncoding::Decode differs from decoding and then checksumming\n");
+        return 1;
+    }
+
+    seconds = MeasureSeconds([&]
+    {
+        Base64Crc32c crc;
+        Base64XxHash64 hash;
+
+        crc.Update(input.data(), length);
+        hash.Update(input.data(), length);
+        base64.Encode(input.data(), length, encoded.data(), encoded.size());
+
+        separateCrc = crc.Digest();
+        separateHash = hash.Digest();
+    });
+
+    PrintResult("Checksum, then encode", length, seconds);
+
+    std::vector<char> expected(encoded);
+
+    seconds = MeasureSeconds([&]
+    {
+        Base64Crc32c crc;
+        Base64XxHash64 hash;
+
+        checksumBase64.Encode(input.data(), length, encoded.data(), encoded.size(), crc, hash);
+
+        fusedCrc = crc.Digest();
+        fusedHash = hash.Digest();
+    });
+
+    PrintResult("Base64ChecksumEncoding::Encode", length, seconds);
+
+    if(fusedCrc != separateCrc || fusedHash != separateHash || encoded != expected)
+    {
+        fprintf(stderr, "Base64ChecksumEncoding::Encode differs from checksumming and then encoding\n");
+        return 1;
+    }
+
+    return 0;
+}
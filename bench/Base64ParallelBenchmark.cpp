@@ -0,0 +1,75 @@
+// Measures parallel encode and decode throughput against the number of threads
+// Usage: Base64ParallelBenchmark [input megabytes] [maximum thread count]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "../src/Base64EncodingParallel.hpp"
+
+// Returns the best throughput, in GB/s, of several runs of the given operation over the given number of bytes
+template<typename Operation>
+double MeasureThroughput(size_t byteCount, Operation operation)
+{
+    double bestSeconds = 0;
+
+    for(int run = 0; run < 5; run++)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        operation();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if(run == 0 || elapsed.count() < bestSeconds)
+        {
+            bestSeconds = elapsed.count();
+        }
+    }
+
+    return byteCount / bestSeconds / 1e9;
+}
+
+int main(int argc, char** argv)
+{
+    size_t inputLength = (size_t)(argc > 1 ? atol(argv[1]) : 256) * 1024 * 1024;
+    size_t maximumThreadCount = argc > 2 ? (size_t)atol(argv[2]) : std::thread::hardware_concurrency();
+
+    if(maximumThreadCount == 0)
+    {
+        maximumThreadCount = 1;
+    }
+
+    Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+    std::vector<uint8_t> input(inputLength);
+    std::vector<char> encoded(base64.EncodedLength(inputLength));
+    std::vector<uint8_t> decoded(inputLength);
+
+    for(size_t i = 0; i < inputLength; i++)
+    {
+        input[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    printf("%zu MB input, %zu hardware threads\n", inputLength / (1024 * 1024), (size_t)std::thread::hardware_concurrency());
+    printf("threads  encode GB/s  decode GB/s\n");
+
+    for(size_t threadCount = 1; threadCount <= maximumThreadCount; threadCount++)
+    {
+        Base64ThreadPool threadPool(threadCount - 1);
+        Base64ParallelEncoding parallelBase64(base64, threadPool);
+
+        double encodeThroughput = MeasureThroughput(inputLength, [&]
+        {
+            parallelBase64.Encode(input.data(), inputLength, encoded.data(), encoded.size());
+        });
+
+        double decodeThroughput = MeasureThroughput(inputLength, [&]
+        {
+            parallelBase64.Decode(encoded.data(), encoded.size(), decoded.data(), decoded.size());
+        });
+
+        printf("%7zu  %11.2f  %11.2f\n", threadCount, encodeThroughput, decodeThroughput);
+    }
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Compares reading, encoding and writing a stream one chunk after another with Base64PipelineEncoding, which overlaps the three
+// The reader and writer copy to and from memory and then wait a fixed time per call, standing in for the latency of storage or a network
+// Usage: base64_pipeline_bench [--size bytes] [--chunk bytes] [--latency microseconds]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "../src/Base64EncodingPipeline.hpp"
+
+// Reads from a buffer a chunk at a time, waiting the given time on every call
+class SlowReader
+{
+    private:
+
+        const std::vector<uint8_t>& Source;
+        size_t Position;
+        std::chrono::microseconds Latency;
+
+    public:
+
+        SlowReader(const std::vector<uint8_t>& source, std::chrono::microseconds latency)
+          : Source(source),
+            Position(0),
+            Latency(latency)
+        {
+
+        }
+
+        int64_t operator()(void* pBuffer, size_t length)
+        {
+            std::this_thread::sleep_for(Latency);
+
+            size_t readLength = length < Source.size() - Position ? length : Source.size() - Position;
+
+            memcpy(pBuffer, Source.data() + Position, readLength);
+            Position += readLength;
+
+            return (int64_t)readLength;
+        }
+};
+
+// Appends to a buffer, waiting the given time on every call
+class SlowWriter
+{
+    private:
+
+        std::vector<char>& Destination;
+        std::chrono::microseconds Latency;
+
+    public:
+
+        SlowWriter(std::vector<char>& destination, std::chrono::microseconds latency)
+          : Destination(destination),
+            Latency(latency)
+        {
+
+        }
+
+        bool operator()(const void* pData, size_t length)
+        {
+            std::this_thread::sleep_for(Latency);
+
+            Destination.insert(Destination.end(), (const char*)pData, (const char*)pData + length);
+
+            return true;
+        }
+};
+
+int main(int argc, char** argv)
+{
+    size_t length = 64 << 20;
+    size_t chunkLength = BASE64ENCODING_PIPELINE_CHUNK_LENGTH;
+    long latency = 200;
+
+    for(int i = 1; i + 1 < argc; i += 2)
+    {
+        if(strcmp(argv[i], "--size") == 0)
+        {
+            length = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--chunk") == 0)
+        {
+            chunkLength = (size_t)strtoull(argv[i + 1], NULL, 10);
+        }
+        else if(strcmp(argv[i], "--latency") == 0)
+        {
+            latency = strtol(argv[i + 1], NULL, 10);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--size bytes] [--chunk bytes] [--latency microseconds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+    Base64PipelineEncoding pipelineBase64(base64, chunkLength, BASE64ENCODING_PIPELINE_BUFFER_COUNT);
+
+    std::vector<uint8_t> input(length);
+    std::vector<char> sequentialOutput;
+    std::vector<char> pipelineOutput;
+
+    for(size_t i = 0; i < length; i++)
+    {
+        input[i] = (uint8_t)(i * 2654435761u >> 24);
+    }
+
+    sequentialOutput.reserve(base64.EncodedLength(length));
+    pipelineOutput.reserve(base64.EncodedLength(length));
+
+    printf("%zu bytes in chunks of %zu, %ld us per read and write\n", length, chunkLength, latency);
+    printf("%-24s  %8s  %8s\n", "", "seconds", "MB/s");
+
+    // Read, encode and write each chunk in turn
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    {
+        SlowReader reader(input, std::chrono::microseconds(latency));
+        SlowWriter writer(sequentialOutput, std::chrono::microseconds(latency));
+        Base64StreamEncoder encoder(base64);
+        std::vector<uint8_t> chunk(chunkLength);
+        std::vector<char> encoded(base64.EncodedLength(chunkLength + 2));
+        int64_t readLength;
+
+        while((readLength = reader(chunk.data(), chunkLength)) > 0)
+        {
+            writer(encoded.data(), (size_t)encoder.Update(chunk.data(), (size_t)readLength, encoded.data(), encoded.size()));
+        }
+
+        writer(encoded.data(), (size_t)encoder.Finish(encoded.data(), encoded.size()));
+    }
+
+    std::chrono::duration<double> sequentialSeconds = std::chrono::steady_clock::now() - start;
+
+    printf("%-24s  %8.3f  %8.1f\n", "Sequential", sequentialSeconds.count(), (double)length / sequentialSeconds.count() / 1e6);
+
+    start = std::chrono::steady_clock::now();
+
+    pipelineBase64.Encode(SlowReader(input, std::chrono::microseconds(latency)), SlowWriter(pipelineOutput, std::chrono::microseconds(latency)));
+
+    std::chrono::duration<double> pipelineSeconds = std::chrono::steady_clock::now() - start;
+
+    printf("%-24s  %8.3f  %8.1f\n", "Base64PipelineEncoding", pipelineSeconds.count(), (double)length / pipelineSeconds.count() / 1e6);
+
+    // A fast but wrong pipeline is not a result
+    if(pipelineOutput != sequentialOutput)
+    {
+        fprintf(stderr, "Base64PipelineEncoding output differs from encoding in turn\n");
+        return 1;
+    }
+
+    return 0;
+}
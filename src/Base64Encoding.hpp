@@ -1,6 +1,15 @@
 #ifndef Base64Encoding_h
 #define Base64Encoding_h
 
+#include <stdint.h>
+#include <string.h>
+
+#include <array>
+#include <deque>
+#include <mutex>
+
+#include "Base64EncodingSimd.hpp"
+
 // Masks for extracting ASCII octets from a 24-bit character grouping
 #define BASE64ENCODING_OCTET1_MASK 0b111111110000000000000000
 #define BASE64ENCODING_OCTET2_MASK 0b000000001111111100000000
@@ -12,7 +21,32 @@
 #define BASE64ENCODING_SEXTET3_MASK 0b000000000000111111000000
 #define BASE64ENCODING_SEXTET4_MASK 0b000000000000000000111111
 
+// Marks characters outside the alphabet in the character to sextet table
+#define BASE64ENCODING_INVALID_SEXTET 0x80
+
+// Returned by EncodedLength when the encoded length cannot be represented in a size_t
+#define BASE64ENCODING_LENGTH_OVERFLOW SIZE_MAX
+
 #define BASE64ENCODING_BUFFER_OVERFLOW -1
+#define BASE64ENCODING_INVALID_CHARACTER -2
+
+// Returned by every encode and decode of a Base64Encoding constructed with an alphabet that cannot round trip
+#define BASE64ENCODING_INVALID_ALPHABET -5
+
+// Opt-in counters of the calls made through Base64Encoding
+#ifdef BASE64ENCODING_INSTRUMENTATION
+#include "Base64EncodingMetrics.hpp"
+#endif
+
+// Number of characters gathered on the stack by DecodeIgnoringWhitespace for lines that cannot be decoded straight from the input
+#define BASE64ENCODING_WHITESPACE_BLOCK_LENGTH 4096
+
+// Number of characters encoded on the stack by a line-wrapped encode whose line length is not a whole number of groups
+#define BASE64ENCODING_LINE_BLOCK_LENGTH 4096
+
+// Number of bytes of short items gathered on the stack by a batch encode, and characters by a batch decode, so that the kernel runs once across many items
+// A multiple of both three and four, so that a block holds whole groups either way
+#define BASE64ENCODING_BATCH_BLOCK_LENGTH 3072
 
 #ifndef BIT_IS_SET
 #define BIT_IS_SET(x, mask) (x & mask)
@@ -24,192 +58,675 @@ typedef enum
     Padded = 0x80
 } Base64EncodingOptions;
 
-class Base64Encoding
+// Line break written between the lines of a line-wrapped encode, valued as its length in characters
+typedef enum
+{
+    Base64LineBreakLf = 1,
+    Base64LineBreakCrlf = 2
+} Base64LineBreak;
+
+// Outcome of a strict decode
+typedef enum
+{
+    Base64DecodeSucceeded = 0,
+    Base64DecodeOutputBufferOverflow,
+    Base64DecodeInvalidCharacter,
+    Base64DecodeInvalidPadding,
+    Base64DecodeInvalidLength,
+    Base64DecodeNonCanonicalTrailingBits,
+    Base64DecodeInvalidAlphabet
+} Base64DecodeStatus;
+
+struct Base64DecodeResult
+{
+    Base64DecodeStatus Status;
+
+    // Number of bytes decoded, or on failure the number decoded from the groups before the error
+    size_t BytesWritten;
+
+    // Offset in the input of the first byte at fault, zero unless the input is rejected
+    size_t ErrorOffset;
+};
+
+// One input of a batch encode or decode, such as a single token among many
+struct Base64BatchItem
+{
+    const void* pData;
+    size_t Length;
+};
+
+// RFC 4648 alphabets
+#define BASE64ENCODING_STANDARD_ALPHABET "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+#define BASE64ENCODING_URL_SAFE_ALPHABET "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+
+// Modified Base64 of IMAP mailbox names, RFC 3501, used unpadded
+#define BASE64ENCODING_IMAP_ALPHABET "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+,"
+
+// Salts and hashes of bcrypt and of the traditional Unix crypt, used unpadded
+#define BASE64ENCODING_BCRYPT_ALPHABET "./ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+#define BASE64ENCODING_CRYPT_ALPHABET "./0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+
+// Lookup tables for an alphabet, built at compile time when its characters are constants
+struct Base64Alphabet
+{
+    char Character62;
+    char Character63;
+
+    // Whether the first 62 characters are the uppercase letters, lowercase letters and digits in that order, as the range-based vectorized kernels assume
+    // Other alphabets are translated by the table vectorized kernels
+    bool StandardLayout;
+
+    // Whether every character is printable ASCII and appears once, so that whatever is encoded decodes back unchanged
+    // Worked out once here, so that checking an alphabet costs nothing on each call
+    bool Distinct;
+
+    // Whether '=' is one of the characters, which then cannot be told apart from padding
+    bool HasPaddingCharacter;
+
+    char EncodeTable[64];
+    uint8_t DecodeTable[256];
+    int8_t EncodeShiftTable[16];
+
+    // Populates the lookup tables for the standard letters and digits followed by the given 62nd and 63rd characters
+    constexpr Base64Alphabet(const char character62, const char character63)
+      : Character62(character62),
+        Character63(character63),
+        StandardLayout(true),
+        Distinct(false),
+        HasPaddingCharacter(false),
+        EncodeTable(),
+        DecodeTable(),
+        EncodeShiftTable()
+    {
+        for(uint8_t sextet = 0; sextet < 64; sextet++)
+        {
+            if(sextet <= 25)
+            {
+                // Uppercase letter
+                EncodeTable[sextet] = sextet + 65;
+            }
+            else if(sextet <= 51)
+            {
+                // Lowercase letter
+                EncodeTable[sextet] = sextet + 71;
+            }
+            else if(sextet <= 61)
+            {
+                // Digit
+                EncodeTable[sextet] = sextet - 4;
+            }
+            else if(sextet == 62)
+            {
+                EncodeTable[sextet] = Character62;
+            }
+            else
+            {
+                EncodeTable[sextet] = Character63;
+            }
+        }
+
+        BuildDecodeTable();
+
+        Base64EncodingSimd::BuildEncodeShiftTable(Character62, Character63, EncodeShiftTable);
+    }
+
+    // Populates the lookup tables for the given 64 characters, in sextet order
+    constexpr Base64Alphabet(const char* pCharacters)
+      : Character62(pCharacters[62]),
+        Character63(pCharacters[63]),
+        StandardLayout(true),
+        Distinct(false),
+        HasPaddingCharacter(false),
+        EncodeTable(),
+        DecodeTable(),
+        EncodeShiftTable()
+    {
+        for(uint8_t sextet = 0; sextet < 64; sextet++)
+        {
+            EncodeTable[sextet] = pCharacters[sextet];
+
+            if(sextet < 62 && pCharacters[sextet] != BASE64ENCODING_STANDARD_ALPHABET[sextet])
+            {
+                StandardLayout = false;
+            }
+        }
+
+        BuildDecodeTable();
+
+        Base64EncodingSimd::BuildEncodeShiftTable(Character62, Character63, EncodeShiftTable);
+    }
+
+    // Populates the character to sextet table from the sextet to character table
+    // Later sextets are assigned first, so a character repeated in the alphabet decodes to its first position
+    constexpr void BuildDecodeTable()
+    {
+        for(size_t character = 0; character < 256; character++)
+        {
+            DecodeTable[character] = BASE64ENCODING_INVALID_SEXTET;
+        }
+
+        for(int sextet = 63; sextet >= 0; sextet--)
+        {
+            DecodeTable[(uint8_t)EncodeTable[sextet]] = (uint8_t)sextet;
+        }
+
+        Distinct = true;
+        HasPaddingCharacter = DecodeTable[(uint8_t)'='] != BASE64ENCODING_INVALID_SEXTET;
+
+        for(uint32_t sextet = 0; sextet < 64; sextet++)
+        {
+            uint8_t character = (uint8_t)EncodeTable[sextet];
+
+            // A repeated character decodes to its first position, so the repeat is found at its second
+            if(character <= ' ' || character >= 0x7F || DecodeTable[character] != sextet)
+            {
+                Distinct = false;
+            }
+        }
+    }
+
+    // Returns whether whatever is encoded with the alphabet decodes back unchanged, with or without padding
+    constexpr bool IsValid(bool padded) const
+    {
+        return Distinct && !(padded && HasPaddingCharacter);
+    }
+
+    // Converts a Base64 sextet to its ASCII character
+    constexpr char SextetToCharacter(uint32_t sextet) const
+    {
+        return EncodeTable[sextet];
+    }
+
+    // Converts an ASCII character to a Base64 sextet, or BASE64ENCODING_INVALID_SEXTET if it is not part of the alphabet
+    constexpr uint32_t CharacterToSextet(char character) const
+    {
+        return DecodeTable[(uint8_t)character];
+    }
+};
+
+// Interns alphabets, so that every Base64Encoding using the same 64 characters shares one set of lookup tables, built the first time the alphabet is used
+// The predefined alphabets are built at compile time and returned without taking the lock, and only other alphabets are interned
+// Interned alphabets are never modified or freed, so references to them stay valid and may be read from any thread
+class Base64AlphabetRegistry
 {
+    public:
+
+        static constexpr Base64Alphabet Standard = Base64Alphabet(BASE64ENCODING_STANDARD_ALPHABET);
+        static constexpr Base64Alphabet UrlSafe = Base64Alphabet(BASE64ENCODING_URL_SAFE_ALPHABET);
+        static constexpr Base64Alphabet Imap = Base64Alphabet(BASE64ENCODING_IMAP_ALPHABET);
+        static constexpr Base64Alphabet Bcrypt = Base64Alphabet(BASE64ENCODING_BCRYPT_ALPHABET);
+        static constexpr Base64Alphabet Crypt = Base64Alphabet(BASE64ENCODING_CRYPT_ALPHABET);
+
+        static_assert(Standard.IsValid(true) && UrlSafe.IsValid(true) && Imap.IsValid(true) && Bcrypt.IsValid(true) && Crypt.IsValid(true), "Predefined alphabets must round trip");
+
     private:
 
-        const char Character62;
-        const char Character63;
-        const Base64EncodingOptions Options;
+        struct Registry
+        {
+            std::mutex Mutex;
+
+            // A deque never moves its elements as it grows
+            std::deque<Base64Alphabet> Alphabets;
+        };
+
+        static Registry& GetRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+    public:
 
-        // Converts a Base64 sextet to its ASCII character
-        char SextetToCharacter(uint8_t sextet)
+        // Returns the shared alphabet of the given 64 characters, in sextet order
+        // Returns NULL if any character is a control character, a space, not ASCII or repeated, as Base64Alphabet::IsValid checks without padding
+        static const Base64Alphabet* Intern(const char* pCharacters)
         {
-            // Check if character represents an uppercase letter
-            if(sextet >= 0 && sextet <= 25)
+            for(const Base64Alphabet* pPredefined : { &Standard, &UrlSafe, &Imap, &Bcrypt, &Crypt })
+            {
+                if(memcmp(pPredefined->EncodeTable, pCharacters, 64) == 0)
+                {
+                    return pPredefined;
+                }
+            }
+
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+
+            for(const Base64Alphabet& alphabet : registry.Alphabets)
             {
-                return sextet + 65;
+                if(memcmp(alphabet.EncodeTable, pCharacters, 64) == 0)
+                {
+                    return &alphabet;
+                }
             }
 
-            // Check if character represents a lowercase letter
-            if(sextet >= 26 && sextet <= 51)
+            // Rejected alphabets are not kept, so every lookup of one builds its tables again
+            Base64Alphabet alphabet(pCharacters);
+
+            if(!alphabet.IsValid(false))
             {
-                return sextet + 71;
+                return NULL;
             }
 
-            // Check if character represents a digit
-            if(sextet >= 52 && sextet <= 61)
+            registry.Alphabets.push_back(alphabet);
+
+            return &registry.Alphabets.back();
+        }
+
+        // Returns the shared alphabet of the standard letters and digits followed by the given 62nd and 63rd characters, or NULL if it is not valid
+        static const Base64Alphabet* Intern(const char character62, const char character63)
+        {
+            // The RFC 4648 pairs are matched without building the full alphabet
+            if(character62 == '+' && character63 == '/')
             {
-                return sextet - 4;
+                return &Standard;
             }
 
-            // 62nd character
-            if(sextet == 62)
+            if(character62 == '-' && character63 == '_')
             {
-                return Character62;
+                return &UrlSafe;
             }
 
-            // 63rd character
-            return Character63;
+            char characters[64];
+
+            memcpy(characters, BASE64ENCODING_STANDARD_ALPHABET, 62);
+            characters[62] = character62;
+            characters[63] = character63;
+
+            return Intern(characters);
+        }
+
+        // Returns the number of distinct alphabets interned so far, not counting the predefined ones
+        static size_t Count()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+
+            return registry.Alphabets.size();
         }
+};
 
-        // Converts an ASCII character to a Base64 sextet
-        uint8_t CharacterToSextet(char character)
+// Encode and decode loops shared by Base64Codec and Base64Encoding
+// Padding is a template parameter so that every tail path is resolved at compile time
+template<bool Padded>
+class Base64EncodingCore
+{
+    private:
+
+        // Encodes the leading groups of three bytes with the given vectorized kernel
+        // Returns the number of input bytes consumed, the remainder is left to the scalar loop
+        static size_t EncodeVectorized(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer)
         {
-            // Check if character is an uppercase letter
-            if(character >= 'A' && character <= 'Z')
+            switch(kernel)
             {
-                return character - 65;
+#ifdef BASE64ENCODING_X86
+                case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+                    return Base64EncodingSimd::EncodeAvx512Vbmi(pInputBuffer, inputLength, pOutputBuffer, alphabet.EncodeTable);
+
+                case Base64EncodingKernel::Base64KernelAvx2:
+                    return alphabet.StandardLayout ? Base64EncodingSimd::EncodeAvx2(pInputBuffer, inputLength, pOutputBuffer, alphabet.EncodeShiftTable)
+                                                   : Base64EncodingSimd::EncodeTableAvx2(pInputBuffer, inputLength, pOutputBuffer, alphabet.EncodeTable);
+
+                case Base64EncodingKernel::Base64KernelSsse3:
+                    return alphabet.StandardLayout ? Base64EncodingSimd::EncodeSsse3(pInputBuffer, inputLength, pOutputBuffer, alphabet.EncodeShiftTable)
+                                                   : Base64EncodingSimd::EncodeTableSsse3(pInputBuffer, inputLength, pOutputBuffer, alphabet.EncodeTable);
+#endif
+
+                default:
+                    return 0;
             }
+        }
+
+        // Encodes the leading lines of the given length, each followed by a line break of the given length, with the selected vectorized kernel
+        // Returns the number of input bytes consumed and sets the number of characters written, the remainder is left to the caller
+        // The SSSE3 and AVX2 line kernels only handle the standard layout, and leave other alphabets to be encoded a line at a time
+        static size_t EncodeLinesVectorized(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputLength,
+                                            size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            writtenLength = 0;
 
-            // Check if character is a lowercase letter
-            if(character >= 'a' && character <= 'z')
+            switch(kernel)
             {
-                return character - 71;
+#ifdef BASE64ENCODING_X86
+                case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+                    return Base64EncodingSimd::EncodeLinesAvx512Vbmi(pInputBuffer, inputLength, pOutputBuffer, outputLength, alphabet.EncodeTable, lineLength, lineBreakLength, writtenLength);
+
+                case Base64EncodingKernel::Base64KernelAvx2:
+                    if(!alphabet.StandardLayout)
+                    {
+                        return 0;
+                    }
+
+                    return Base64EncodingSimd::EncodeLinesAvx2(pInputBuffer, inputLength, pOutputBuffer, outputLength, alphabet.EncodeShiftTable, lineLength, lineBreakLength, writtenLength);
+
+                case Base64EncodingKernel::Base64KernelSsse3:
+                    if(!alphabet.StandardLayout)
+                    {
+                        return 0;
+                    }
+
+                    return Base64EncodingSimd::EncodeLinesSsse3(pInputBuffer, inputLength, pOutputBuffer, outputLength, alphabet.EncodeShiftTable, lineLength, lineBreakLength, writtenLength);
+#endif
+
+                default:
+                    return 0;
             }
+        }
 
-            // Check if character is a digit
-            if(character >= '0'  && character <= '9')
+        // Decodes the leading groups of four characters with the given vectorized kernel
+        // Returns the number of input characters consumed, the remainder is left to the scalar loop
+        static size_t DecodeVectorized(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer)
+        {
+            switch(kernel)
             {
-                return character + 4;
+#ifdef BASE64ENCODING_X86
+                // A single permute looks up any alphabet, faster than the range checks of the AVX2 kernel even for the standard layout
+                case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+                    return Base64EncodingSimd::DecodeTableAvx512Vbmi(pInputBuffer, inputLength, pOutputBuffer, alphabet.DecodeTable);
+
+                case Base64EncodingKernel::Base64KernelAvx2:
+                    return alphabet.StandardLayout ? Base64EncodingSimd::DecodeAvx2(pInputBuffer, inputLength, pOutputBuffer, alphabet.Character62, alphabet.Character63)
+                                                   : Base64EncodingSimd::DecodeTableAvx2(pInputBuffer, inputLength, pOutputBuffer, alphabet.DecodeTable);
+
+                case Base64EncodingKernel::Base64KernelSsse3:
+                    return alphabet.StandardLayout ? Base64EncodingSimd::DecodeSsse3(pInputBuffer, inputLength, pOutputBuffer, alphabet.Character62, alphabet.Character63)
+                                                   : Base64EncodingSimd::DecodeTableSsse3(pInputBuffer, inputLength, pOutputBuffer, alphabet.DecodeTable);
+#endif
+
+                default:
+                    return 0;
             }
+        }
+
+        // Decodes the leading lines of the given length, each followed by a line break of the given length, with the selected vectorized kernel
+        // Returns the number of input characters consumed and sets the number of bytes written, the remainder is left to the caller
+        // The line kernels only handle the standard layout, and leave other alphabets to be decoded a line at a time
+        static size_t DecodeLinesVectorized(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength,
+                                            size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            writtenLength = 0;
 
-            // 62nd character
-            if(character == Character62)
+            if(!alphabet.StandardLayout)
             {
-                return 62;
+                return 0;
             }
 
-            // 63rd character
-            return 63;
+            switch(kernel)
+            {
+#ifdef BASE64ENCODING_X86
+                case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+                case Base64EncodingKernel::Base64KernelAvx2:
+                    return Base64EncodingSimd::DecodeLinesAvx2(pInputBuffer, inputLength, pOutputBuffer, outputBufferLength, alphabet.Character62, alphabet.Character63, lineLength, lineBreakLength, writtenLength);
+
+                case Base64EncodingKernel::Base64KernelSsse3:
+                    return Base64EncodingSimd::DecodeLinesSsse3(pInputBuffer, inputLength, pOutputBuffer, outputBufferLength, alphabet.Character62, alphabet.Character63, lineLength, lineBreakLength, writtenLength);
+#endif
+
+                default:
+                    return 0;
+            }
         }
 
-    public:
+        // Returns true for the characters skipped by DecodeIgnoringWhitespace
+        static constexpr bool IsWhitespace(char character)
+        {
+            return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+        }
 
-        Base64Encoding(const char character62, const char character63, const Base64EncodingOptions options)
-          : Character62(character62),
-            Character63(character63),
-            Options(options)
+        // Decodes whole groups of four characters and returns every decoded sextet ORed together
+        // The vectorized kernel may read on up to readableLength characters, which stops it at the first block holding a character outside the alphabet,
+        // and may store up to (readableLength / 4) * 3 bytes
+        static uint32_t DecodeGroups(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t characterCount, size_t readableLength, uint8_t* pOutputBuffer)
         {
+            size_t vectorizedLength = DecodeVectorized(alphabet, kernel, pInputBuffer, readableLength, pOutputBuffer);
+
+            // Any whole blocks decoded beyond the groups requested were valid, so only the requested groups need counting
+            if(vectorizedLength > characterCount)
+            {
+                vectorizedLength = characterCount;
+            }
 
+            return DecodeScalar(alphabet, pInputBuffer + vectorizedLength, ((characterCount - vectorizedLength) / 4) * 3, pOutputBuffer + (vectorizedLength / 4) * 3);
         }
 
-        uint32_t EncodedLength(uint32_t inputLength)
+        // Decodes the whole groups gathered from between whitespace
+        // Returns the number of bytes written, BASE64ENCODING_BUFFER_OVERFLOW or BASE64ENCODING_INVALID_CHARACTER
+        static int64_t DecodeBlock(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pBlock, size_t blockLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
         {
-            // Every set of three ASCII characters will be encoded into four base64 characters
-            uint32_t encodedLength = (inputLength / 3) * 4;
-
-            // Check if any ASCII characters were not grouped into a set of three
-            uint8_t ungroupedCharacters = inputLength % 3;
+            size_t decodedLength = (blockLength / 4) * 3;
 
-            if(BIT_IS_SET(Options, Base64EncodingOptions::Padded))
+            if(outputBufferLength < decodedLength)
             {
-                if(ungroupedCharacters != 0)
-                {
-                    // Some ASCII characters were ungrouped
-                    // With padding, an additional four Base64 characters are required to encode them
-                    encodedLength += 4;
-                }
+                return BASE64ENCODING_BUFFER_OVERFLOW;
             }
-            else
+
+            if(BIT_IS_SET(DecodeGroups(alphabet, kernel, pBlock, blockLength, blockLength, pOutputBuffer), BASE64ENCODING_INVALID_SEXTET))
             {
-                if(ungroupedCharacters == 1)
-                {
-                    // A single ASCII character remains ungrouped
-                    // Without padding, an additional two Base64 characters are required to encode it
-                    encodedLength += 2;
-                }
-                else if(ungroupedCharacters == 2)
-                {
-                    // Two ASCII characters remain ungrouped
-                    // Without padding, an additional three Base64 characters are required to encode them
-                    encodedLength += 3;
-                }
+                return BASE64ENCODING_INVALID_CHARACTER;
             }
 
-            return encodedLength;
+            return (int64_t)decodedLength;
         }
 
-        uint32_t DecodedLength(char* pInputBuffer, uint32_t inputLength)
+        // Encodes the items from firstItem up to lastItem gathered by EncodeBatch, each completed to a whole group with zero bytes
+        static void EncodeBatchBlock(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pBlock, size_t blockLength,
+                                     const Base64BatchItem* pItems, size_t firstItem, size_t lastItem, char* pOutputBuffer, const size_t* pOffsets)
         {
-            // Every set of four Base64 characters will be decoded into three ASCII characters
-            uint32_t decodedLength = (inputLength / 4) * 3;
+            if(blockLength == 0)
+            {
+                return;
+            }
 
-            if(BIT_IS_SET(Options, Base64EncodingOptions::Padded))
+            if(Padded)
             {
-                // Check for Base64 padding characters at end of input
-                if(pInputBuffer[inputLength - 1] == '=')
+                // Padded items take exactly the characters their completed groups encode to, so the block is encoded straight into place
+                // and the characters encoding the zero bytes are then replaced by padding
+                char* pOutput = pOutputBuffer + pOffsets[firstItem];
+
+                Encode(alphabet, kernel, pBlock, blockLength, pOutput, (blockLength / 3) * 4);
+
+                for(size_t i = firstItem; i < lastItem; i++)
                 {
-                    if(pInputBuffer[inputLength - 2] == '=')
-                    {
-                        // Two Base64 padding characters found
-                        decodedLength -= 2;
-                    }
-                    else
+                    switch(pItems[i].Length % 3)
                     {
-                        // One Base64 padding character found
-                        decodedLength -= 1;
+                        case 1:
+                            pOutputBuffer[pOffsets[i + 1] - 2] = '=';
+                            pOutputBuffer[pOffsets[i + 1] - 1] = '=';
+                            break;
+
+                        case 2:
+                            pOutputBuffer[pOffsets[i + 1] - 1] = '=';
+                            break;
                     }
                 }
             }
             else
             {
-                // Check if any Base64 characters were not grouped into a set of four
-                uint8_t ungroupedCharacters = inputLength % 4;
+                // Unpadded items are shorter than their completed groups, so each one is copied out of the encoded block
+                char encodedBlock[(BASE64ENCODING_BATCH_BLOCK_LENGTH / 3) * 4];
+                size_t encodedBlockOffset = 0;
 
-                if(ungroupedCharacters == 2)
-                {
-                    // Two Base64 characters remain ungrouped, they will be decoded into one additional ASCII character
-                    decodedLength += 1;
-                }
-                else if(ungroupedCharacters == 3)
+                Encode(alphabet, kernel, pBlock, blockLength, encodedBlock, sizeof(encodedBlock));
+
+                for(size_t i = firstItem; i < lastItem; i++)
                 {
-                    // Three Base64 characters remain ungrouped, they will be decoded into two additional ASCII characters
-                    decodedLength += 2;
+                    memcpy(pOutputBuffer + pOffsets[i], encodedBlock + encodedBlockOffset, pOffsets[i + 1] - pOffsets[i]);
+
+                    encodedBlockOffset += ((pItems[i].Length + 2) / 3) * 4;
                 }
             }
+        }
 
-            return decodedLength;
+        // Decodes the items from firstItem up to lastItem gathered by DecodeBatch, each completed to a whole group, and copies each one into place
+        // Returns false if the block holds a character outside the alphabet
+        static bool DecodeBatchBlock(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pBlock, size_t blockLength,
+                                     size_t firstItem, size_t lastItem, uint8_t* pOutputBuffer, const size_t* pOffsets)
+        {
+            uint8_t decodedBlock[(BASE64ENCODING_BATCH_BLOCK_LENGTH / 4) * 3];
+            size_t decodedBlockOffset = 0;
+
+            if(BIT_IS_SET(DecodeGroups(alphabet, kernel, pBlock, blockLength, blockLength, decodedBlock), BASE64ENCODING_INVALID_SEXTET))
+            {
+                return false;
+            }
+
+            for(size_t i = firstItem; i < lastItem; i++)
+            {
+                size_t decodedLength = pOffsets[i + 1] - pOffsets[i];
+
+                memcpy(pOutputBuffer + pOffsets[i], decodedBlock + decodedBlockOffset, decodedLength);
+
+                decodedBlockOffset += ((decodedLength + 2) / 3) * 3;
+            }
+
+            return true;
+        }
+
+        // Encodes the input into an output buffer already known to hold the given number of characters, without measuring either again
+        static void EncodeSized(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer)
+        {
+            // Encode as many groupings as possible with the vectorized kernel
+            size_t vectorizedLength = EncodeVectorized(alphabet, kernel, pInputBuffer, inputLength, pOutputBuffer);
+
+            // Encode the remaining groupings and any ungrouped bytes with the lookup tables
+            EncodeScalar(alphabet, pInputBuffer + vectorizedLength, inputLength - vectorizedLength, pOutputBuffer + (vectorizedLength / 3) * 4);
+        }
+
+        // Decodes the given number of bytes into an output buffer already known to hold them, without reading the input for padding again
+        // Returns the decoded length or BASE64ENCODING_INVALID_CHARACTER
+        static int64_t DecodeSized(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t decodedLength, uint8_t* pOutputBuffer)
+        {
+            // Decode as many groupings as possible with the vectorized kernel
+            // It validates characters as it translates them and leaves any block holding an invalid character to the scalar loop
+            size_t vectorizedLength = DecodeVectorized(alphabet, kernel, pInputBuffer, (decodedLength / 3) * 4, pOutputBuffer);
+            size_t vectorizedDecodedLength = (vectorizedLength / 4) * 3;
+
+            // Decode the remaining groupings and any ungrouped characters with the lookup tables
+            uint32_t sextets = DecodeScalar(alphabet, pInputBuffer + vectorizedLength, decodedLength - vectorizedDecodedLength, pOutputBuffer + vectorizedDecodedLength);
+
+            if(BIT_IS_SET(sextets, BASE64ENCODING_INVALID_SEXTET))
+            {
+                return BASE64ENCODING_INVALID_CHARACTER;
+            }
+
+            return (int64_t)decodedLength;
+        }
+
+    public:
+
+        // Returns the length of the Base64 string the input encodes to, or BASE64ENCODING_LENGTH_OVERFLOW if it exceeds the range of a size_t
+        static constexpr size_t EncodedLength(size_t inputLength)
+        {
+            // Verify the four Base64 characters per set of three ASCII characters, plus up to four for an ungrouped set, can be counted
+            if((inputLength / 3) > ((SIZE_MAX - 4) / 4))
+            {
+                return BASE64ENCODING_LENGTH_OVERFLOW;
+            }
+
+            // Every set of three ASCII characters will be encoded into four base64 characters
+            size_t ungroupedCharacters = inputLength % 3;
+
+            // With padding, one or two ungrouped ASCII characters take another four Base64 characters
+            // Without padding, they take two or three, which is (ungroupedCharacters * 4 + 2) / 3 rounded down
+            return (inputLength / 3) * 4 + (Padded ? ((ungroupedCharacters + 2) / 3) * 4 : (ungroupedCharacters * 4 + 2) / 3);
+        }
+
+        // Returns the length of the Base64 string the input encodes to when broken into lines of the given length, with a line break between lines and none after the final line
+        // A line length of zero writes no line breaks, and BASE64ENCODING_LENGTH_OVERFLOW is returned if the length exceeds the range of a size_t
+        static constexpr size_t EncodedLength(size_t inputLength, size_t lineLength, Base64LineBreak lineBreak)
+        {
+            size_t encodedLength = EncodedLength(inputLength);
+
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || encodedLength == 0 || lineLength == 0)
+            {
+                return encodedLength;
+            }
+
+            // Every line but the last is followed by a line break
+            size_t lineBreakCount = (encodedLength - 1) / lineLength;
+
+            if(lineBreakCount > (SIZE_MAX - 1 - encodedLength) / (size_t)lineBreak)
+            {
+                return BASE64ENCODING_LENGTH_OVERFLOW;
+            }
+
+            return encodedLength + lineBreakCount * (size_t)lineBreak;
+        }
+
+        // Returns whether Base64 text of the given length can be decoded without dropping characters
+        // Padded text must end in a complete set of four, and unpadded text must not end in a single character, which cannot encode a whole byte
+        static constexpr bool IsValidLength(size_t inputLength)
+        {
+            return Padded ? inputLength % 4 == 0 : inputLength % 4 != 1;
+        }
+
+        static constexpr size_t DecodedLength(const char* pInputBuffer, size_t inputLength)
+        {
+            // Every set of four Base64 characters will be decoded into three ASCII characters
+            size_t decodedLength = (inputLength / 4) * 3;
+
+            if(Padded)
+            {
+                // Padding characters can only end a set of four, so shorter input has its final two characters read from a stand-in instead
+                // Selecting the pointer rather than branching on the characters keeps the count free of branches
+                const char* pFinalCharacters = decodedLength > 0 ? pInputBuffer + inputLength - 2 : "AA";
+                size_t lastIsPadding = pFinalCharacters[1] == '=';
+
+                return decodedLength - lastIsPadding - (lastIsPadding & (size_t)(pFinalCharacters[0] == '='));
+            }
+
+            // Two or three Base64 characters not grouped into a set of four decode to one or two more ASCII characters, and a single one to none
+            return decodedLength + ((inputLength % 4) * 3) / 4;
+        }
+
+        // Returns the largest number of bytes the given number of characters can decode to, whatever whitespace or padding they hold
+        // Sizes the output buffer for DecodeIgnoringWhitespace without scanning the input
+        static constexpr size_t DecodedLengthUpperBound(size_t inputLength)
+        {
+            return (inputLength / 4) * 3 + ((inputLength % 4) * 3) / 4;
         }
 
         // Converts a ASCII string into a Base64 string
         // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
-        int32_t Encode(char* pInputBuffer, char* pOutputBuffer, uint32_t outputBufferLength)
+        static int64_t Encode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, char* pInputBuffer, char* pOutputBuffer, size_t outputBufferLength)
         {
-            uint32_t inputLength = strlen(pInputBuffer);
-            uint32_t encodedLength = EncodedLength(inputLength);
+            size_t inputLength = strlen(pInputBuffer);
+            size_t encodedLength = EncodedLength(inputLength);
 
             // Verify the output buffer is large enough to hold the encoded string and null terminator
-            if(outputBufferLength < (encodedLength + 1))
+            if(encodedLength >= outputBufferLength)
             {
                 return BASE64ENCODING_BUFFER_OVERFLOW;
             }
 
-            uint32_t groupedCharacterSetCount = inputLength / 3;
+            EncodeSized(alphabet, kernel, (const uint8_t*)pInputBuffer, inputLength, pOutputBuffer);
+
+            // Terminate the output buffer
+            pOutputBuffer[encodedLength] = '\0';
+
+            return (int64_t)encodedLength;
+        }
+
+        // Encodes every group of three bytes and any ungrouped bytes with the lookup tables, without checking the output buffer
+        // Usable in constant expressions, where the input is a string literal or std::array
+        template<typename TInput>
+        static constexpr void EncodeScalar(const Base64Alphabet& alphabet, const TInput* pInputBuffer, size_t inputLength, char* pOutputBuffer)
+        {
+            size_t groupedCharacterSetCount = inputLength / 3;
             uint8_t ungroupedCharacterCount = inputLength % 3;
-            uint32_t characterSet;
+            uint32_t characterSet = 0;
 
             // Loop through every grouping of three ASCII characters
-            for (uint32_t i = 0; i < groupedCharacterSetCount; i++)
+            for (size_t i = 0; i < groupedCharacterSetCount; i++)
             {
                 // Pack the three ASCII characters into a 24-bit integer
-                characterSet = (pInputBuffer[0] << 16) | (pInputBuffer[1] << 8) | pInputBuffer[2];
+                characterSet = ((uint8_t)pInputBuffer[0] << 16) | ((uint8_t)pInputBuffer[1] << 8) | (uint8_t)pInputBuffer[2];
 
                 // Extract and encode each of the four Base64 sextets
-                pOutputBuffer[0] = SextetToCharacter(characterSet >> 18);
-                pOutputBuffer[1] = SextetToCharacter((characterSet & BASE64ENCODING_SEXTET2_MASK) >> 12);
-                pOutputBuffer[2] = SextetToCharacter((characterSet & BASE64ENCODING_SEXTET3_MASK) >> 6);
-                pOutputBuffer[3] = SextetToCharacter((characterSet & BASE64ENCODING_SEXTET4_MASK));
+                pOutputBuffer[0] = alphabet.SextetToCharacter(characterSet >> 18);
+                pOutputBuffer[1] = alphabet.SextetToCharacter((characterSet & BASE64ENCODING_SEXTET2_MASK) >> 12);
+                pOutputBuffer[2] = alphabet.SextetToCharacter((characterSet & BASE64ENCODING_SEXTET3_MASK) >> 6);
+                pOutputBuffer[3] = alphabet.SextetToCharacter((characterSet & BASE64ENCODING_SEXTET4_MASK));
 
                 // Advance buffer pointers
                 pInputBuffer += 3;
@@ -222,13 +739,13 @@ class Base64Encoding
                 case 1:
 
                     // Pack the single remaining ASCII character into a 24-bit integer
-                    characterSet = pInputBuffer[0] << 16;
+                    characterSet = (uint8_t)pInputBuffer[0] << 16;
 
                     // Extract and encode the two Base64 characters
-                    pOutputBuffer[0] = SextetToCharacter(characterSet >> 18);
-                    pOutputBuffer[1] = SextetToCharacter((characterSet & BASE64ENCODING_SEXTET2_MASK) >> 12);
+                    pOutputBuffer[0] = alphabet.SextetToCharacter(characterSet >> 18);
+                    pOutputBuffer[1] = alphabet.SextetToCharacter((characterSet & BASE64ENCODING_SEXTET2_MASK) >> 12);
 
-                    if(BIT_IS_SET(Options, Base64EncodingOptions::Padded))
+                    if(Padded)
                     {
                         // Add Base64 padding characters
                         pOutputBuffer[2] = '=';
@@ -246,14 +763,14 @@ class Base64Encoding
                 case 2:
 
                     // Pack the single remaining ASCII characters into a 24-bit integer
-                    characterSet = (pInputBuffer[0] << 16) | (pInputBuffer[1] << 8);
+                    characterSet = ((uint8_t)pInputBuffer[0] << 16) | ((uint8_t)pInputBuffer[1] << 8);
 
                     // Extract and encode the three Base64 characters
-                    pOutputBuffer[0] = SextetToCharacter(characterSet >> 18);
-                    pOutputBuffer[1] = SextetToCharacter((characterSet & BASE64ENCODING_SEXTET2_MASK) >> 12);
-                    pOutputBuffer[2] = SextetToCharacter((characterSet & BASE64ENCODING_SEXTET3_MASK) >> 6);
+                    pOutputBuffer[0] = alphabet.SextetToCharacter(characterSet >> 18);
+                    pOutputBuffer[1] = alphabet.SextetToCharacter((characterSet & BASE64ENCODING_SEXTET2_MASK) >> 12);
+                    pOutputBuffer[2] = alphabet.SextetToCharacter((characterSet & BASE64ENCODING_SEXTET3_MASK) >> 6);
                     
-                    if(BIT_IS_SET(Options, Base64EncodingOptions::Padded))
+                    if(Padded)
                     {
                         // Add Base64 padding characters
                         pOutputBuffer[3] = '=';
@@ -267,80 +784,1432 @@ class Base64Encoding
 
                     break;
             }
+        }
+
+        // Converts binary data of the given length into a Base64 string
+        // The input may contain null bytes and the output is not null terminated
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
+        static int64_t Encode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            size_t encodedLength = EncodedLength(inputLength);
+
+            // Verify the output buffer is large enough to hold the encoded string
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || outputBufferLength < encodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
 
-            // Terminate the output buffer            
-            pOutputBuffer[0] = '\0';
+            EncodeSized(alphabet, kernel, pInputBuffer, inputLength, pOutputBuffer);
 
-            return encodedLength;
+            return (int64_t)encodedLength;
         }
 
-        // Converts a Base64 string into a ASCII string
-        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded string
-        uint32_t Decode(char* pInputBuffer, char* pOutputBuffer, uint32_t outputBufferLength)
+        // Converts binary data of the given length into a Base64 string, or measures it if it does not fit, as snprintf does
+        // The output is not null terminated
+        // Returns the length of the encoded string, written only if it is no longer than the output buffer, so a longer result is the length to reserve
+        // before calling again, or BASE64ENCODING_BUFFER_OVERFLOW if the length exceeds the range of a size_t
+        static int64_t TryEncode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
         {
-            uint32_t inputLength = strlen(pInputBuffer);
-            uint32_t decodedLength = DecodedLength(pInputBuffer, inputLength);
+            size_t encodedLength = EncodedLength(inputLength);
 
-            // Verify the output buffer is large enough to hold the decoded string and null terminator
-            if(outputBufferLength < (decodedLength + 1))
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW)
             {
                 return BASE64ENCODING_BUFFER_OVERFLOW;
             }
 
-            uint32_t groupedCharacterSetCount = decodedLength / 3;
-            uint8_t ungroupedCharacterCount = decodedLength % 3;
-            uint32_t characterSet;
-
-            // Loop through every grouping of four Base64 characters
-            for(uint32_t i = 0; i < groupedCharacterSetCount; i++)
+            if(encodedLength <= outputBufferLength)
             {
-                // Pack the four Base64 characters into a 24-bit integer
-                characterSet = (CharacterToSextet(pInputBuffer[0]) << 18) | (CharacterToSextet(pInputBuffer[1]) << 12) | (CharacterToSextet(pInputBuffer[2]) << 6) | CharacterToSextet(pInputBuffer[3]);
+                EncodeSized(alphabet, kernel, pInputBuffer, inputLength, pOutputBuffer);
+            }
 
-                // Extract and encode each of the three ASCII characters
-                pOutputBuffer[0] = characterSet >> 16;
-                pOutputBuffer[1] = (characterSet & BASE64ENCODING_OCTET2_MASK) >> 8;
-                pOutputBuffer[2] = (characterSet & BASE64ENCODING_OCTET3_MASK);
+            return (int64_t)encodedLength;
+        }
 
-                // Advance buffer pointers
-                pInputBuffer += 4;
-                pOutputBuffer += 3;
+        // Converts binary data of the given length into a Base64 string broken into lines of the given length, as used by MIME and PEM
+        // Line breaks are written as the output is produced, between lines and not after the final one, and a line length of zero writes no line breaks
+        // Line lengths that are a multiple of four take whole lines per step, otherwise the output is encoded a block at a time and copied out around the line breaks
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
+        static int64_t Encode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength,
+                              size_t lineLength, Base64LineBreak lineBreak)
+        {
+            size_t encodedLength = EncodedLength(inputLength, lineLength, lineBreak);
+
+            // Verify the output buffer is large enough to hold the encoded string
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || outputBufferLength < encodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
             }
 
-            // Check if any Base64 characters were not grouped into a set of three
-            switch(decodedLength % 3)
+            // A single line needs no line breaks
+            if(encodedLength <= lineLength || lineLength == 0)
             {
-                case 1:
+                return Encode(alphabet, kernel, pInputBuffer, inputLength, pOutputBuffer, encodedLength);
+            }
 
-                    // Pack the two remaining Base64 characters into a 24-bit integer
-                    characterSet = (CharacterToSextet(pInputBuffer[0]) << 18) | (CharacterToSextet(pInputBuffer[1]) << 12);
+            const char* pLineBreak = lineBreak == Base64LineBreak::Base64LineBreakCrlf ? "\r\n" : "\n";
+            size_t lineBreakLength = (size_t)lineBreak;
+            size_t consumed = 0;
+            size_t writtenLength = 0;
 
-                    // Extract and decode the single ASCII character
-                    pOutputBuffer[0] = characterSet >> 16;
+            if(lineLength % 4 == 0)
+            {
+                size_t lineInputLength = (lineLength / 4) * 3;
 
-                    pOutputBuffer += 1;
+                // Encode as many lines as possible with the vectorized kernel, whose stores stay within the encoded string
+                consumed = EncodeLinesVectorized(alphabet, kernel, pInputBuffer, inputLength, pOutputBuffer, encodedLength, lineLength, lineBreakLength, writtenLength);
 
-                    break;
+                // Encode the remaining lines followed by further input one at a time
+                while(inputLength - consumed > lineInputLength)
+                {
+                    Encode(alphabet, kernel, pInputBuffer + consumed, lineInputLength, pOutputBuffer + writtenLength, lineLength);
+                    memcpy(pOutputBuffer + writtenLength + lineLength, pLineBreak, lineBreakLength);
+
+                    consumed += lineInputLength;
+                    writtenLength += lineLength + lineBreakLength;
+                }
+
+                // The final line may be short, padded or incomplete
+                Encode(alphabet, kernel, pInputBuffer + consumed, inputLength - consumed, pOutputBuffer + writtenLength, encodedLength - writtenLength);
+
+                return (int64_t)encodedLength;
+            }
+
+            // Lines split groups, so encode whole groups into a block and copy them out, with a line break before every line after the first
+            char block[BASE64ENCODING_LINE_BLOCK_LENGTH];
+            size_t column = 0;
+
+            while(consumed < inputLength)
+            {
+                size_t blockInputLength = (sizeof(block) / 4) * 3;
+
+                if(blockInputLength > inputLength - consumed)
+                {
+                    blockInputLength = inputLength - consumed;
+                }
+
+                size_t blockLength = (size_t)Encode(alphabet, kernel, pInputBuffer + consumed, blockInputLength, block, sizeof(block));
+
+                for(size_t i = 0; i < blockLength;)
+                {
+                    if(column == lineLength)
+                    {
+                        memcpy(pOutputBuffer + writtenLength, pLineBreak, lineBreakLength);
+
+                        writtenLength += lineBreakLength;
+                        column = 0;
+                    }
+
+                    size_t length = lineLength - column < blockLength - i ? lineLength - column : blockLength - i;
+
+                    memcpy(pOutputBuffer + writtenLength, block + i, length);
+
+                    i += length;
+                    writtenLength += length;
+                    column += length;
+                }
+
+                consumed += blockInputLength;
+            }
+
+            return (int64_t)encodedLength;
+        }
+
+        // Converts binary data at the start of the buffer into a Base64 string written over the same buffer
+        // The raw bytes are first moved to the end of the buffer, after which every encoded group lands behind the bytes still to be read,
+        // by the scalar loop and the vectorized kernels alike
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the buffer is not large enough to hold the encoded string
+        static int64_t EncodeInPlace(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, char* pBuffer, size_t inputLength, size_t bufferLength)
+        {
+            size_t encodedLength = EncodedLength(inputLength);
+
+            // Verify the buffer is large enough to hold the encoded string
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || bufferLength < encodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            size_t inputOffset = encodedLength - inputLength;
+
+            memmove(pBuffer + inputOffset, pBuffer, inputLength);
+
+            return Encode(alphabet, kernel, (const uint8_t*)pBuffer + inputOffset, inputLength, pBuffer, encodedLength);
+        }
+
+        // Converts a Base64 string into a ASCII string
+        // Returns the length of the decoded string, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded string
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        static int64_t Decode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, char* pInputBuffer, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            size_t inputLength = strlen(pInputBuffer);
+            size_t expectedLength = DecodedLength(pInputBuffer, inputLength);
+
+            // Verify the output buffer is large enough to hold the decoded string and null terminator
+            if(expectedLength >= outputBufferLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            int64_t decodedLength = DecodeSized(alphabet, kernel, pInputBuffer, expectedLength, (uint8_t*)pOutputBuffer);
+
+            // Terminate the output buffer
+            if(decodedLength >= 0)
+            {
+                pOutputBuffer[decodedLength] = '\0';
+            }
+
+            return decodedLength;
+        }
+
+        // Decodes the given number of bytes with the lookup tables, without checking the input for padding or the output buffer
+        // Returns every decoded sextet ORed together, which has BASE64ENCODING_INVALID_SEXTET set if any character is outside the alphabet
+        // Usable in constant expressions
+        static constexpr uint32_t DecodeScalar(const Base64Alphabet& alphabet, const char* pInputBuffer, size_t decodedLength, uint8_t* pOutputBuffer)
+        {
+            size_t groupedCharacterSetCount = decodedLength / 3;
+            uint8_t ungroupedCharacterCount = decodedLength % 3;
+            uint32_t characterSet = 0;
+
+            // Every sextet is accumulated so that a character outside the alphabet can be detected once at the end
+            uint32_t sextets = 0;
+
+            // Loop through every grouping of four Base64 characters
+            for(size_t i = 0; i < groupedCharacterSetCount; i++)
+            {
+                uint32_t sextet1 = alphabet.CharacterToSextet(pInputBuffer[0]);
+                uint32_t sextet2 = alphabet.CharacterToSextet(pInputBuffer[1]);
+                uint32_t sextet3 = alphabet.CharacterToSextet(pInputBuffer[2]);
+                uint32_t sextet4 = alphabet.CharacterToSextet(pInputBuffer[3]);
+
+                sextets |= sextet1 | sextet2 | sextet3 | sextet4;
+
+                // Pack the four Base64 characters into a 24-bit integer
+                characterSet = (sextet1 << 18) | (sextet2 << 12) | (sextet3 << 6) | sextet4;
+
+                // Extract and encode each of the three ASCII characters
+                pOutputBuffer[0] = characterSet >> 16;
+                pOutputBuffer[1] = (characterSet & BASE64ENCODING_OCTET2_MASK) >> 8;
+                pOutputBuffer[2] = (characterSet & BASE64ENCODING_OCTET3_MASK);
+
+                // Advance buffer pointers
+                pInputBuffer += 4;
+                pOutputBuffer += 3;
+            }
+
+            // Check if any Base64 characters were not grouped into a set of three
+            switch(ungroupedCharacterCount)
+            {
+                case 1:
+                {
+                    uint32_t sextet1 = alphabet.CharacterToSextet(pInputBuffer[0]);
+                    uint32_t sextet2 = alphabet.CharacterToSextet(pInputBuffer[1]);
+
+                    sextets |= sextet1 | sextet2;
+
+                    // Pack the two remaining Base64 characters into a 24-bit integer
+                    characterSet = (sextet1 << 18) | (sextet2 << 12);
+
+                    // Extract and decode the single ASCII character
+                    pOutputBuffer[0] = characterSet >> 16;
+
+                    pOutputBuffer += 1;
+
+                    break;
+                }
 
                 case 2:
+                {
+                    uint32_t sextet1 = alphabet.CharacterToSextet(pInputBuffer[0]);
+                    uint32_t sextet2 = alphabet.CharacterToSextet(pInputBuffer[1]);
+                    uint32_t sextet3 = alphabet.CharacterToSextet(pInputBuffer[2]);
+
+                    sextets |= sextet1 | sextet2 | sextet3;
 
                     // Pack the three remaining Base64 characters into a 24-bit integer
-                    characterSet = (CharacterToSextet(pInputBuffer[0]) << 18) | (CharacterToSextet(pInputBuffer[1]) << 12) | (CharacterToSextet(pInputBuffer[2]) << 6);
+                    characterSet = (sextet1 << 18) | (sextet2 << 12) | (sextet3 << 6);
 
                     // Extract and decode the two ASCII characters
                     pOutputBuffer[0] = characterSet >> 16;
                     pOutputBuffer[1] = (characterSet & BASE64ENCODING_OCTET2_MASK) >> 8;
-                    
+
                     pOutputBuffer += 2;
 
                     break;
+                }
             }
 
-            // Terminate the output buffer    
-            pOutputBuffer[0] = '\0';
+            return sextets;
+        }
 
-            return decodedLength;
+        // Converts a Base64 string of the given length into binary data
+        // The input does not need to be null terminated and the output is not null terminated
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        static int64_t Decode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            size_t decodedLength = DecodedLength(pInputBuffer, inputLength);
+
+            // Verify the output buffer is large enough to hold the decoded data
+            if(outputBufferLength < decodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            return DecodeSized(alphabet, kernel, pInputBuffer, decodedLength, pOutputBuffer);
+        }
+
+        // Converts a Base64 string of the given length into binary data, or measures it if it does not fit, as snprintf does
+        // The input does not need to be null terminated and is read once, and the output is not null terminated
+        // Returns the length of the decoded data, written only if it is no longer than the output buffer, so a longer result is the length to reserve
+        // before calling again, or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet, which is only checked as it is decoded
+        static int64_t TryDecode(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            size_t decodedLength = DecodedLength(pInputBuffer, inputLength);
+
+            if(outputBufferLength < decodedLength)
+            {
+                return (int64_t)decodedLength;
+            }
+
+            return DecodeSized(alphabet, kernel, pInputBuffer, decodedLength, pOutputBuffer);
+        }
+
+        // Converts a Base64 string of the given length into binary data, rejecting any input that is not exactly what Encode produces
+        // Padded input must be a whole number of sets of four ending in at most two padding characters, unpadded input must contain none,
+        // and the bits beyond the final byte in the last character must be zero
+        // Valid input is validated as it is decoded, only rejected input is scanned again to find the offset of the error
+        static Base64DecodeResult DecodeStrict(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            Base64DecodeResult result = { Base64DecodeStatus::Base64DecodeSucceeded, 0, 0 };
+            uint8_t ungroupedCharacters = inputLength % 4;
+            size_t paddingLength = 0;
+
+            if(!IsValidLength(inputLength))
+            {
+                result.Status = Base64DecodeStatus::Base64DecodeInvalidLength;
+                result.ErrorOffset = inputLength - ungroupedCharacters;
+
+                return result;
+            }
+
+            if(Padded)
+            {
+                // Up to two padding characters may end the final set of four, any others are found below as misplaced
+                while(paddingLength < 2 && paddingLength < inputLength && pInputBuffer[inputLength - paddingLength - 1] == '=')
+                {
+                    paddingLength++;
+                }
+            }
+
+            // Every character before the padding must be part of the alphabet
+            size_t characterCount = inputLength - paddingLength;
+            uint8_t finalCharacterCount = characterCount % 4;
+            size_t decodedLength = (characterCount / 4) * 3 + (finalCharacterCount != 0 ? finalCharacterCount - 1 : 0);
+
+            // Verify the output buffer is large enough to hold the decoded data
+            if(outputBufferLength < decodedLength)
+            {
+                result.Status = Base64DecodeStatus::Base64DecodeOutputBufferOverflow;
+
+                return result;
+            }
+
+            size_t vectorizedLength = DecodeVectorized(alphabet, kernel, pInputBuffer, (characterCount / 4) * 4, pOutputBuffer);
+            size_t vectorizedDecodedLength = (vectorizedLength / 4) * 3;
+
+            uint32_t sextets = DecodeScalar(alphabet, pInputBuffer + vectorizedLength, decodedLength - vectorizedDecodedLength, pOutputBuffer + vectorizedDecodedLength);
+
+            if(BIT_IS_SET(sextets, BASE64ENCODING_INVALID_SEXTET))
+            {
+                // Find the first character outside the alphabet, where a padding character is reported as misplaced
+                size_t offset = vectorizedLength;
+
+                while(!BIT_IS_SET(alphabet.CharacterToSextet(pInputBuffer[offset]), BASE64ENCODING_INVALID_SEXTET))
+                {
+                    offset++;
+                }
+
+                result.Status = pInputBuffer[offset] == '=' ? Base64DecodeStatus::Base64DecodeInvalidPadding : Base64DecodeStatus::Base64DecodeInvalidCharacter;
+                result.BytesWritten = (offset / 4) * 3;
+                result.ErrorOffset = offset;
+
+                return result;
+            }
+
+            // A final set of two or three characters carries four or two bits beyond its last byte, which Encode always leaves zero
+            if(finalCharacterCount != 0)
+            {
+                uint32_t unusedBitsMask = finalCharacterCount == 2 ? 0x0F : 0x03;
+
+                if(alphabet.CharacterToSextet(pInputBuffer[characterCount - 1]) & unusedBitsMask)
+                {
+                    result.Status = Base64DecodeStatus::Base64DecodeNonCanonicalTrailingBits;
+                    result.BytesWritten = (characterCount / 4) * 3;
+                    result.ErrorOffset = characterCount - 1;
+
+                    return result;
+                }
+            }
+
+            result.BytesWritten = decodedLength;
+
+            return result;
+        }
+
+        // Converts a Base64 string of the given length into binary data, skipping spaces, tabs, carriage returns and line feeds anywhere in it
+        // Lines of the same length as the first, ending in LF or CRLF and holding whole groups, take a fast path
+        // The vectorized kernels decode them straight from the input, otherwise short lines are copied whole into a block on the stack,
+        // which is decoded once full, and long lines are decoded straight from the input
+        // Any other characters are gathered into the block one at a time
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        static int64_t DecodeIgnoringWhitespace(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            char block[BASE64ENCODING_WHITESPACE_BLOCK_LENGTH];
+            size_t blockLength = 0;
+            size_t decodedLength = 0;
+            size_t position = 0;
+            int64_t blockDecodedLength;
+
+            // Input position of the first character in the block, and whether the block holds lines copied without looking for whitespace in them
+            size_t blockPosition = 0;
+            bool blockHasCopiedLines = false;
+
+            // Input before this position is gathered a character at a time, after a block of copied lines turned out to hold whitespace
+            size_t gatheredPosition = 0;
+
+            // The first line sets the line length of the fast path
+            size_t lineLength = 0;
+            size_t lineBreakLength = 0;
+
+            while(lineLength < inputLength && !IsWhitespace(pInputBuffer[lineLength]))
+            {
+                lineLength++;
+            }
+
+            if(lineLength > 0 && lineLength % 4 == 0 && lineLength < inputLength)
+            {
+                if(pInputBuffer[lineLength] == '\n')
+                {
+                    lineBreakLength = 1;
+                }
+                else if(pInputBuffer[lineLength] == '\r' && lineLength + 1 < inputLength && pInputBuffer[lineLength + 1] == '\n')
+                {
+                    lineBreakLength = 2;
+                }
+            }
+
+            while(true)
+            {
+                bool wholeLine = lineBreakLength != 0 &&
+                                 position >= gatheredPosition &&
+                                 blockLength % 4 == 0 &&
+                                 inputLength - position >= lineLength + lineBreakLength &&
+                                 pInputBuffer[position + lineLength + lineBreakLength - 1] == '\n' &&
+                                 (lineBreakLength == 1 || pInputBuffer[position + lineLength] == '\r');
+
+                // Decode as many lines as the vectorized kernel can straight from the input
+                if(wholeLine && blockLength == 0)
+                {
+                    size_t writtenLength;
+                    size_t vectorizedLength = DecodeLinesVectorized(alphabet, kernel, pInputBuffer + position, inputLength - position, pOutputBuffer + decodedLength, outputBufferLength - decodedLength,
+                                                                    lineLength, lineBreakLength, writtenLength);
+
+                    if(vectorizedLength > 0)
+                    {
+                        position += vectorizedLength;
+                        decodedLength += writtenLength;
+
+                        continue;
+                    }
+                }
+
+                // Decode a long line straight from the input
+                if(wholeLine && blockLength == 0 && lineLength > sizeof(block) && outputBufferLength - decodedLength >= (lineLength / 4) * 3)
+                {
+                    // The kernel reads on past the line until the block holding the line break, with its stores kept within the output buffer
+                    size_t readableLength = ((outputBufferLength - decodedLength) / 3) * 4;
+
+                    if(readableLength > inputLength - position)
+                    {
+                        readableLength = inputLength - position;
+                    }
+
+                    // A line holding padding, other whitespace or a character outside the alphabet is gathered a character at a time instead
+                    if(BIT_IS_SET(DecodeGroups(alphabet, kernel, pInputBuffer + position, lineLength, readableLength, pOutputBuffer + decodedLength), BASE64ENCODING_INVALID_SEXTET))
+                    {
+                        gatheredPosition = position + lineLength + lineBreakLength;
+                    }
+                    else
+                    {
+                        position += lineLength + lineBreakLength;
+                        decodedLength += (lineLength / 4) * 3;
+                    }
+
+                    continue;
+                }
+
+                // Skip whitespace without touching the block, so that a block ending in padding is only decoded if more characters follow
+                if(position < inputLength && !wholeLine && IsWhitespace(pInputBuffer[position]))
+                {
+                    position++;
+
+                    continue;
+                }
+
+                // Decode the block once the input ends or the next line or character does not fit
+                bool blockFull = wholeLine ? (sizeof(block) - blockLength < lineLength) : (blockLength == sizeof(block));
+
+                if(position == inputLength || blockFull)
+                {
+                    if(position == inputLength)
+                    {
+                        // The final groups may be padded or incomplete
+                        blockDecodedLength = Decode(alphabet, kernel, block, blockLength, pOutputBuffer + decodedLength, outputBufferLength - decodedLength);
+                    }
+                    else
+                    {
+                        blockDecodedLength = DecodeBlock(alphabet, kernel, block, blockLength, pOutputBuffer + decodedLength, outputBufferLength - decodedLength);
+                    }
+
+                    if(blockDecodedLength < 0 && blockHasCopiedLines)
+                    {
+                        // A copied line may have held whitespace, which also counts towards the output length, so gather the characters of the block again one at a time
+                        gatheredPosition = position;
+                        position = blockPosition;
+                        blockLength = 0;
+                        blockHasCopiedLines = false;
+
+                        continue;
+                    }
+
+                    if(blockDecodedLength < 0)
+                    {
+                        return blockDecodedLength;
+                    }
+
+                    decodedLength += (size_t)blockDecodedLength;
+                    blockLength = 0;
+                    blockHasCopiedLines = false;
+
+                    if(position == inputLength)
+                    {
+                        return (int64_t)decodedLength;
+                    }
+                }
+
+                if(blockLength == 0)
+                {
+                    blockPosition = position;
+                }
+
+                if(wholeLine)
+                {
+                    // Copy a short line whole
+                    memcpy(block + blockLength, pInputBuffer + position, lineLength);
+
+                    blockLength += lineLength;
+                    position += lineLength + lineBreakLength;
+                    blockHasCopiedLines = true;
+                }
+                else
+                {
+                    block[blockLength++] = pInputBuffer[position++];
+                }
+            }
+        }
+
+        // Converts the Base64 string at the start of a larger buffer into binary data, stopping at the terminator or the end of the buffer
+        // Suits strings inside JSON documents, whose escaped solidus "\/" is decoded as '/' and whose closing quote is the terminator,
+        // so a parser can decode a field straight from the document into its final destination
+        // Runs between escapes are decoded straight from the input, with only the groups split by an escape gathered on the stack
+        // Returns the length of the decoded data and sets the number of characters consumed, including the terminator if found,
+        // BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the string contains a character outside the alphabet or any other escape
+        // On failure the consumed length is left unchanged and the output buffer contents are unspecified
+        static int64_t DecodeDelimited(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const char* pInputBuffer, size_t inputLength, char terminator,
+                                       uint8_t* pOutputBuffer, size_t outputBufferLength, size_t& consumedLength)
+        {
+            char group[4];
+            size_t groupLength = 0;
+            size_t decodedLength = 0;
+            size_t position = 0;
+            int64_t blockDecodedLength;
+
+            while(true)
+            {
+                // Find the end of the run of plain characters
+                size_t runEnd = position;
+
+#ifdef BASE64ENCODING_X86
+                if(kernel != Base64EncodingKernel::Base64KernelScalar)
+                {
+                    runEnd += Base64EncodingSimd::FindEitherCharacterSse2(pInputBuffer + position, inputLength - position, '\\', terminator);
+                }
+#endif
+
+                while(runEnd < inputLength && pInputBuffer[runEnd] != '\\' && pInputBuffer[runEnd] != terminator)
+                {
+                    runEnd++;
+                }
+
+                bool finalRun = runEnd == inputLength || pInputBuffer[runEnd] == terminator;
+
+                // Complete a group split by an escape, which may only hold padding if it ends the string
+                while(groupLength > 0 && groupLength < 4 && position < runEnd)
+                {
+                    group[groupLength++] = pInputBuffer[position++];
+                }
+
+                if(groupLength == 4 && (position < runEnd || !finalRun))
+                {
+                    blockDecodedLength = DecodeBlock(alphabet, kernel, group, groupLength, pOutputBuffer + decodedLength, outputBufferLength - decodedLength);
+
+                    if(blockDecodedLength < 0)
+                    {
+                        return blockDecodedLength;
+                    }
+
+                    decodedLength += (size_t)blockDecodedLength;
+                    groupLength = 0;
+                }
+
+                if(finalRun)
+                {
+                    // The final groups may be padded or incomplete
+                    if(groupLength > 0)
+                    {
+                        blockDecodedLength = Decode(alphabet, kernel, group, groupLength, pOutputBuffer + decodedLength, outputBufferLength - decodedLength);
+                    }
+                    else
+                    {
+                        blockDecodedLength = Decode(alphabet, kernel, pInputBuffer + position, runEnd - position, pOutputBuffer + decodedLength, outputBufferLength - decodedLength);
+                    }
+
+                    if(blockDecodedLength < 0)
+                    {
+                        return blockDecodedLength;
+                    }
+
+                    consumedLength = runEnd < inputLength ? runEnd + 1 : runEnd;
+
+                    return (int64_t)(decodedLength + (size_t)blockDecodedLength);
+                }
+
+                // Decode the whole groups before the escape and keep the rest for the group it splits
+                size_t wholeLength = ((runEnd - position) / 4) * 4;
+
+                blockDecodedLength = DecodeBlock(alphabet, kernel, pInputBuffer + position, wholeLength, pOutputBuffer + decodedLength, outputBufferLength - decodedLength);
+
+                if(blockDecodedLength < 0)
+                {
+                    return blockDecodedLength;
+                }
+
+                decodedLength += (size_t)blockDecodedLength;
+
+                for(position += wholeLength; position < runEnd; position++)
+                {
+                    group[groupLength++] = pInputBuffer[position];
+                }
+
+                // Only the escaped solidus can stand for a character of the alphabet
+                if(runEnd + 1 >= inputLength || pInputBuffer[runEnd + 1] != '/')
+                {
+                    return BASE64ENCODING_INVALID_CHARACTER;
+                }
+
+                group[groupLength++] = '/';
+                position = runEnd + 2;
+            }
+        }
+
+        // Converts a Base64 string into a ASCII string written over the start of the same buffer
+        // Returns the length of the decoded string or BASE64ENCODING_INVALID_CHARACTER, in which case the buffer contents are unspecified
+        static int64_t DecodeInPlace(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, char* pBuffer)
+        {
+            int64_t decodedLength = DecodeInPlace(alphabet, kernel, pBuffer, strlen(pBuffer));
+
+            // Terminate the decoded string, which is always shorter than the Base64 string
+            if(decodedLength >= 0)
+            {
+                pBuffer[decodedLength] = '\0';
+            }
+
+            return decodedLength;
+        }
+
+        // Converts a Base64 string of the given length into binary data written over the start of the same buffer
+        // Every group of four characters is read before its three bytes are written, by the scalar loop and the vectorized kernels alike,
+        // and the write position never passes the read position, so no separate output buffer is needed
+        // Returns the length of the decoded data or BASE64ENCODING_INVALID_CHARACTER, in which case the buffer contents are unspecified
+        static int64_t DecodeInPlace(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, char* pBuffer, size_t length)
+        {
+            // The decoded data always fits in the buffer, so the output length check cannot fail
+            return Decode(alphabet, kernel, pBuffer, length, (uint8_t*)pBuffer, length);
+        }
+
+        // Returns the total length of the Base64 strings the items of a batch encode to, or BASE64ENCODING_LENGTH_OVERFLOW if it exceeds the range of a size_t
+        static size_t EncodedBatchLength(const Base64BatchItem* pItems, size_t itemCount)
+        {
+            size_t outputLength = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                size_t encodedLength = EncodedLength(pItems[i].Length);
+
+                if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || encodedLength >= BASE64ENCODING_LENGTH_OVERFLOW - outputLength)
+                {
+                    return BASE64ENCODING_LENGTH_OVERFLOW;
+                }
+
+                outputLength += encodedLength;
+            }
+
+            return outputLength;
+        }
+
+        // Returns the total length of the data the Base64 strings of a batch decode to
+        static size_t DecodedBatchLength(const Base64BatchItem* pItems, size_t itemCount)
+        {
+            size_t outputLength = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                outputLength += DecodedLength((const char*)pItems[i].pData, pItems[i].Length);
+            }
+
+            return outputLength;
+        }
+
+        // Converts every item of a batch of binary inputs into a Base64 string, written one after another into a single output buffer
+        // The offsets array holds itemCount + 1 entries, item i is encoded to [pOffsets[i], pOffsets[i + 1]) of the output and nothing is null terminated
+        // Short items are gathered into a block on the stack, each completed to a whole group with zero bytes, and the block is encoded in one go,
+        // so the kernel runs across many items instead of leaving most of each short item to the scalar loop
+        // Returns the total length of the encoded strings or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold them,
+        // in which case the output and offsets are unspecified
+        static int64_t EncodeBatch(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const Base64BatchItem* pItems, size_t itemCount, char* pOutputBuffer, size_t outputBufferLength, size_t* pOffsets)
+        {
+            // Two spare bytes let the zero bytes completing the final group of an item be written unconditionally
+            uint8_t block[BASE64ENCODING_BATCH_BLOCK_LENGTH + 2];
+            size_t blockLength = 0;
+            size_t blockItem = 0;
+            size_t outputLength = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                size_t inputLength = pItems[i].Length;
+                size_t encodedLength = EncodedLength(inputLength);
+
+                // Verify the output buffer is large enough to hold the encoded string
+                if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || outputBufferLength - outputLength < encodedLength)
+                {
+                    return BASE64ENCODING_BUFFER_OVERFLOW;
+                }
+
+                pOffsets[i] = outputLength;
+
+                // The scalar loop and long items gain nothing from the block, so they are encoded straight from the input once the items before them are
+                bool straightFromInput = kernel == Base64EncodingKernel::Base64KernelScalar || inputLength > BASE64ENCODING_BATCH_BLOCK_LENGTH / 4;
+
+                if(straightFromInput || inputLength > BASE64ENCODING_BATCH_BLOCK_LENGTH - blockLength)
+                {
+                    EncodeBatchBlock(alphabet, kernel, block, blockLength, pItems, blockItem, i, pOutputBuffer, pOffsets);
+
+                    blockLength = 0;
+                    blockItem = i;
+                }
+
+                if(straightFromInput)
+                {
+                    Encode(alphabet, kernel, (const uint8_t*)pItems[i].pData, inputLength, pOutputBuffer + outputLength, encodedLength);
+
+                    blockItem = i + 1;
+                }
+                else
+                {
+                    memcpy(block + blockLength, pItems[i].pData, inputLength);
+                    block[blockLength + inputLength] = 0;
+                    block[blockLength + inputLength + 1] = 0;
+
+                    blockLength += ((inputLength + 2) / 3) * 3;
+                }
+
+                outputLength += encodedLength;
+            }
+
+            pOffsets[itemCount] = outputLength;
+
+            EncodeBatchBlock(alphabet, kernel, block, blockLength, pItems, blockItem, itemCount, pOutputBuffer, pOffsets);
+
+            return (int64_t)outputLength;
+        }
+
+        // Converts every item of a batch of Base64 strings into binary data, written one after another into a single output buffer
+        // The offsets array holds itemCount + 1 entries, and item i is decoded to [pOffsets[i], pOffsets[i + 1]) of the output
+        // Short items are gathered into a block on the stack, with any ungrouped characters and padding replaced by the first character of the alphabet,
+        // and the block is decoded in one go before each item is copied out
+        // Returns the total length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold it
+        // or BASE64ENCODING_INVALID_CHARACTER if an item contains a character outside the alphabet, in which case the output and offsets are unspecified
+        static int64_t DecodeBatch(const Base64Alphabet& alphabet, Base64EncodingKernel kernel, const Base64BatchItem* pItems, size_t itemCount, uint8_t* pOutputBuffer, size_t outputBufferLength, size_t* pOffsets)
+        {
+            // Three spare characters let the characters completing the final group of an item be written unconditionally
+            char block[BASE64ENCODING_BATCH_BLOCK_LENGTH + 3];
+            size_t blockLength = 0;
+            size_t blockItem = 0;
+            size_t outputLength = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                const char* pInputBuffer = (const char*)pItems[i].pData;
+                size_t inputLength = pItems[i].Length;
+                size_t decodedLength = DecodedLength(pInputBuffer, inputLength);
+
+                // Verify the output buffer is large enough to hold the decoded data
+                if(outputBufferLength - outputLength < decodedLength)
+                {
+                    return BASE64ENCODING_BUFFER_OVERFLOW;
+                }
+
+                pOffsets[i] = outputLength;
+
+                // Only the characters Decode reads are gathered, so that the block accepts and rejects exactly what Decode does
+                size_t characterCount = (decodedLength / 3) * 4 + (decodedLength % 3 != 0 ? decodedLength % 3 + 1 : 0);
+                size_t groupedLength = ((characterCount + 3) / 4) * 4;
+
+                // The scalar loop and long items gain nothing from the block, so they are decoded straight from the input once the items before them are
+                bool straightFromInput = kernel == Base64EncodingKernel::Base64KernelScalar || groupedLength > BASE64ENCODING_BATCH_BLOCK_LENGTH / 4;
+
+                if(straightFromInput || groupedLength > BASE64ENCODING_BATCH_BLOCK_LENGTH - blockLength)
+                {
+                    if(blockLength > 0 && !DecodeBatchBlock(alphabet, kernel, block, blockLength, blockItem, i, pOutputBuffer, pOffsets))
+                    {
+                        return BASE64ENCODING_INVALID_CHARACTER;
+                    }
+
+                    blockLength = 0;
+                    blockItem = i;
+                }
+
+                if(straightFromInput)
+                {
+                    if(Decode(alphabet, kernel, pInputBuffer, inputLength, pOutputBuffer + outputLength, decodedLength) < 0)
+                    {
+                        return BASE64ENCODING_INVALID_CHARACTER;
+                    }
+
+                    blockItem = i + 1;
+                }
+                else
+                {
+                    memcpy(block + blockLength, pInputBuffer, characterCount);
+                    block[blockLength + characterCount] = 'A';
+                    block[blockLength + characterCount + 1] = 'A';
+                    block[blockLength + characterCount + 2] = 'A';
+
+                    blockLength += groupedLength;
+                }
+
+                outputLength += decodedLength;
+            }
+
+            pOffsets[itemCount] = outputLength;
+
+            // Items gathering no characters decode to nothing, so an empty block needs no decoding
+            if(blockLength > 0 && !DecodeBatchBlock(alphabet, kernel, block, blockLength, blockItem, itemCount, pOutputBuffer, pOffsets))
+            {
+                return BASE64ENCODING_INVALID_CHARACTER;
+            }
+
+            return (int64_t)outputLength;
+        }
+};
+
+// Base64 codec whose alphabet and padding are fixed at compile time
+// The lookup tables are constants and every padding branch is removed, so the loops can be fully specialized and inlined
+// The kernel is the most capable one supported by the processor
+template<char C62, char C63, bool Padded>
+class Base64Codec
+{
+    private:
+
+        typedef Base64EncodingCore<Padded> Core;
+
+        // Deliberately not constexpr, so reaching it while evaluating a constant expression stops compilation
+        static void ConstantIsInvalid()
+        {
+
+        }
+
+    public:
+
+        static constexpr Base64Alphabet Alphabet = Base64Alphabet(C62, C63);
+
+        static_assert(Alphabet.IsValid(Padded), "The 62nd and 63rd characters must be printable, distinct from the letters, the digits and each other, and not '=' when padded");
+
+        static constexpr size_t EncodedLength(size_t inputLength)
+        {
+            return Core::EncodedLength(inputLength);
+        }
+
+        static constexpr size_t EncodedLength(size_t inputLength, size_t lineLength, Base64LineBreak lineBreak)
+        {
+            return Core::EncodedLength(inputLength, lineLength, lineBreak);
+        }
+
+        static constexpr size_t DecodedLength(const char* pInputBuffer, size_t inputLength)
+        {
+            return Core::DecodedLength(pInputBuffer, inputLength);
+        }
+
+        static constexpr size_t DecodedLengthUpperBound(size_t inputLength)
+        {
+            return Core::DecodedLengthUpperBound(inputLength);
+        }
+
+        // Behaves as Base64Encoding::Encode
+        static int64_t Encode(char* pInputBuffer, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::Encode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, pOutputBuffer, outputBufferLength);
+        }
+
+        static int64_t Encode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::Encode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+        static int64_t Encode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength, size_t lineLength, Base64LineBreak lineBreak)
+        {
+            return Core::Encode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength, lineLength, lineBreak);
+        }
+
+        // Behaves as Base64Encoding::TryEncode
+        static int64_t TryEncode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::TryEncode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+        // Behaves as Base64Encoding::EncodeInPlace
+        static int64_t EncodeInPlace(char* pBuffer, size_t inputLength, size_t bufferLength)
+        {
+            return Core::EncodeInPlace(Alphabet, Base64EncodingSimd::SupportedKernel(), pBuffer, inputLength, bufferLength);
+        }
+
+        // Behaves as Base64Encoding::Decode
+        static int64_t Decode(char* pInputBuffer, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::Decode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, pOutputBuffer, outputBufferLength);
+        }
+
+        static int64_t Decode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::Decode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+        // Behaves as Base64Encoding::TryDecode
+        static int64_t TryDecode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::TryDecode(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+        // Behaves as Base64Encoding::DecodeIgnoringWhitespace
+        static int64_t DecodeIgnoringWhitespace(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::DecodeIgnoringWhitespace(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+        // Behaves as Base64Encoding::DecodeDelimited
+        static int64_t DecodeDelimited(const char* pInputBuffer, size_t inputLength, char terminator, uint8_t* pOutputBuffer, size_t outputBufferLength, size_t& consumedLength)
+        {
+            return Core::DecodeDelimited(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, terminator, pOutputBuffer, outputBufferLength, consumedLength);
+        }
+
+        // Behaves as Base64Encoding::DecodeStrict
+        static Base64DecodeResult DecodeStrict(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Core::DecodeStrict(Alphabet, Base64EncodingSimd::SupportedKernel(), pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+        // Behaves as Base64Encoding::DecodeInPlace
+        static int64_t DecodeInPlace(char* pBuffer)
+        {
+            return Core::DecodeInPlace(Alphabet, Base64EncodingSimd::SupportedKernel(), pBuffer);
+        }
+
+        static int64_t DecodeInPlace(char* pBuffer, size_t length)
+        {
+            return Core::DecodeInPlace(Alphabet, Base64EncodingSimd::SupportedKernel(), pBuffer, length);
+        }
+
+        static size_t EncodedBatchLength(const Base64BatchItem* pItems, size_t itemCount)
+        {
+            return Core::EncodedBatchLength(pItems, itemCount);
+        }
+
+        static size_t DecodedBatchLength(const Base64BatchItem* pItems, size_t itemCount)
+        {
+            return Core::DecodedBatchLength(pItems, itemCount);
+        }
+
+        // Behaves as Base64Encoding::EncodeBatch
+        static int64_t EncodeBatch(const Base64BatchItem* pItems, size_t itemCount, char* pOutputBuffer, size_t outputBufferLength, size_t* pOffsets)
+        {
+            return Core::EncodeBatch(Alphabet, Base64EncodingSimd::SupportedKernel(), pItems, itemCount, pOutputBuffer, outputBufferLength, pOffsets);
+        }
+
+        // Behaves as Base64Encoding::DecodeBatch
+        static int64_t DecodeBatch(const Base64BatchItem* pItems, size_t itemCount, uint8_t* pOutputBuffer, size_t outputBufferLength, size_t* pOffsets)
+        {
+            return Core::DecodeBatch(Alphabet, Base64EncodingSimd::SupportedKernel(), pItems, itemCount, pOutputBuffer, outputBufferLength, pOffsets);
+        }
+
+        // Converts a string literal, excluding its null terminator, into a Base64 string at compile time
+        // The result is not null terminated
+        template<size_t InputSize>
+        static constexpr std::array<char, Core::EncodedLength(InputSize - 1)> EncodeConstant(const char (&input)[InputSize])
+        {
+            std::array<char, Core::EncodedLength(InputSize - 1)> encoded{};
+
+            Core::EncodeScalar(Alphabet, input, InputSize - 1, encoded.data());
+
+            return encoded;
+        }
+
+        // Converts binary data into a Base64 string at compile time
+        template<size_t InputLength>
+        static constexpr std::array<char, Core::EncodedLength(InputLength)> EncodeConstant(const std::array<uint8_t, InputLength>& input)
+        {
+            std::array<char, Core::EncodedLength(InputLength)> encoded{};
+
+            Core::EncodeScalar(Alphabet, input.data(), InputLength, encoded.data());
+
+            return encoded;
+        }
+
+        // Converts a Base64 string literal into binary data at compile time
+        // OutputLength must equal DecodedLength of the literal, BASE64ENCODING_DECODE_CONSTANT supplies it
+        // A mismatched length or a character outside the alphabet makes the result not a constant expression
+        template<size_t OutputLength, size_t InputSize>
+        static constexpr std::array<uint8_t, OutputLength> DecodeConstant(const char (&input)[InputSize])
+        {
+            std::array<uint8_t, OutputLength> decoded{};
+
+            if(Core::DecodedLength(input, InputSize - 1) != OutputLength)
+            {
+                ConstantIsInvalid();
+            }
+
+            uint32_t sextets = Core::DecodeScalar(Alphabet, input, OutputLength, decoded.data());
+
+            if(BIT_IS_SET(sextets, BASE64ENCODING_INVALID_SEXTET))
+            {
+                ConstantIsInvalid();
+            }
+
+            return decoded;
+        }
+};
+
+// Decodes a Base64 string literal with the given codec at compile time, into a std::array of exactly the decoded length
+#define BASE64ENCODING_DECODE_CONSTANT(codec, literal) codec::DecodeConstant<codec::DecodedLength(literal, sizeof(literal) - 1)>(literal)
+
+// RFC 4648 alphabets
+typedef Base64Codec<'+', '/', true> Base64StandardCodec;
+typedef Base64Codec<'+', '/', false> Base64StandardUnpaddedCodec;
+typedef Base64Codec<'-', '_', true> Base64UrlSafeCodec;
+typedef Base64Codec<'-', '_', false> Base64UrlSafeUnpaddedCodec;
+
+// Base64 codec whose alphabet and padding are chosen at runtime
+// Each call selects the matching specialization of the shared loops once, rather than branching on the options per character
+class Base64Encoding
+{
+    private:
+
+        // Lookup tables of the configured alphabet, shared through Base64AlphabetRegistry with every instance using the same characters
+        // The standard alphabet stands in for one that was rejected, which every encode and decode then reports
+        const Base64Alphabet& Alphabet;
+        const bool AlphabetValid;
+        const Base64EncodingOptions Options;
+
+        // Instruction set used for the bulk of each encode and decode
+        Base64EncodingKernel Kernel;
+
+        bool IsPadded()
+        {
+            return BIT_IS_SET(Options, Base64EncodingOptions::Padded);
+        }
+
+        Base64Encoding(const Base64Alphabet* pAlphabet, const Base64EncodingOptions options)
+          : Alphabet(pAlphabet != NULL ? *pAlphabet : Base64AlphabetRegistry::Standard),
+            AlphabetValid(pAlphabet != NULL && pAlphabet->IsValid(BIT_IS_SET(options, Base64EncodingOptions::Padded))),
+            Options(options),
+            Kernel(Base64EncodingSimd::SupportedKernel())
+        {
+
+        }
+
+        // Makes the call and, when BASE64ENCODING_INSTRUMENTATION is defined, records it in Base64Metrics
+        // An encoding with a rejected alphabet makes no call and returns BASE64ENCODING_INVALID_ALPHABET
+        template<typename TCall>
+        int64_t Instrumented(bool decoding, size_t inputLength, TCall call)
+        {
+            if(!AlphabetValid)
+            {
+                return BASE64ENCODING_INVALID_ALPHABET;
+            }
+
+#ifdef BASE64ENCODING_INSTRUMENTATION
+            uint64_t start = Base64Metrics::StartCall();
+            int64_t result = call();
+
+            Base64Metrics::Record(decoding ? Base64MetricsOperation::Base64MetricsDecoding : Base64MetricsOperation::Base64MetricsEncoding, Kernel, inputLength, result, start);
+
+            return result;
+#else
+            (void)decoding;
+            (void)inputLength;
+
+            return call();
+#endif
+        }
+
+        // Measures a null terminated input only when the call is recorded
+        template<typename TCall>
+        int64_t Instrumented(bool decoding, const char* pInputBuffer, TCall call)
+        {
+#ifdef BASE64ENCODING_INSTRUMENTATION
+            return Instrumented(decoding, strlen(pInputBuffer), call);
+#else
+            (void)pInputBuffer;
+
+            return Instrumented(decoding, (size_t)0, call);
+#endif
+        }
+
+        // Measures the items of a batch only when the call is recorded, counting the batch as a single call
+        template<typename TCall>
+        int64_t Instrumented(bool decoding, const Base64BatchItem* pItems, size_t itemCount, TCall call)
+        {
+#ifdef BASE64ENCODING_INSTRUMENTATION
+            size_t inputLength = 0;
+
+            for(size_t i = 0; i < itemCount; i++)
+            {
+                inputLength += pItems[i].Length;
+            }
+
+            return Instrumented(decoding, inputLength, call);
+#else
+            (void)pItems;
+            (void)itemCount;
+
+            return Instrumented(decoding, (size_t)0, call);
+#endif
+        }
+
+    public:
+
+        // An alphabet that cannot round trip, such as one whose 62nd or 63rd character is a letter, a digit or, with padding, '=', is rejected
+        // and every encode and decode returns BASE64ENCODING_INVALID_ALPHABET, which IsValid reports up front
+        Base64Encoding(const char character62, const char character63, const Base64EncodingOptions options)
+          : Base64Encoding(Base64AlphabetRegistry::Intern(character62, character63), options)
+        {
+
+        }
+
+        // Uses the given 64 characters, in sextet order, such as BASE64ENCODING_BCRYPT_ALPHABET
+        Base64Encoding(const char* pAlphabet, const Base64EncodingOptions options)
+          : Base64Encoding(Base64AlphabetRegistry::Intern(pAlphabet), options)
+        {
+
+        }
+
+        // Returns whether the alphabet was accepted
+        bool IsValid()
+        {
+            return AlphabetValid;
+        }
+
+        // Returns the lookup tables of the configured alphabet
+        const Base64Alphabet& GetAlphabet()
+        {
+            return Alphabet;
+        }
+
+        // Returns the options the encoding was configured with
+        Base64EncodingOptions GetOptions()
+        {
+            return Options;
+        }
+
+        // Returns the instruction set currently used by Encode and Decode
+        Base64EncodingKernel GetKernel()
+        {
+            return Kernel;
+        }
+
+        // Restricts Encode and Decode to the given instruction set
+        // Returns false and leaves the current kernel unchanged if the processor does not support it
+        bool SetKernel(Base64EncodingKernel kernel)
+        {
+            if(kernel > Base64EncodingSimd::SupportedKernel())
+            {
+                return false;
+            }
+
+            Kernel = kernel;
+
+            return true;
+        }
+
+        // Returns the length of the Base64 string the input encodes to, or BASE64ENCODING_LENGTH_OVERFLOW if it exceeds the range of a size_t
+        size_t EncodedLength(size_t inputLength)
+        {
+            return IsPadded() ? Base64EncodingCore<true>::EncodedLength(inputLength) : Base64EncodingCore<false>::EncodedLength(inputLength);
+        }
+
+        // Returns the length of the Base64 string the input encodes to when broken into lines of the given length, with a line break between lines and none after the final line
+        // A line length of zero writes no line breaks, and BASE64ENCODING_LENGTH_OVERFLOW is returned if the length exceeds the range of a size_t
+        size_t EncodedLength(size_t inputLength, size_t lineLength, Base64LineBreak lineBreak)
+        {
+            return IsPadded() ? Base64EncodingCore<true>::EncodedLength(inputLength, lineLength, lineBreak) : Base64EncodingCore<false>::EncodedLength(inputLength, lineLength, lineBreak);
+        }
+
+        size_t DecodedLength(const char* pInputBuffer, size_t inputLength)
+        {
+            return IsPadded() ? Base64EncodingCore<true>::DecodedLength(pInputBuffer, inputLength) : Base64EncodingCore<false>::DecodedLength(pInputBuffer, inputLength);
+        }
+
+        // Returns whether Base64 text of the given length can be decoded without dropping characters, as DecodeStrict checks before reporting Base64DecodeInvalidLength
+        bool IsValidLength(size_t inputLength)
+        {
+            return IsPadded() ? Base64EncodingCore<true>::IsValidLength(inputLength) : Base64EncodingCore<false>::IsValidLength(inputLength);
+        }
+
+        // Returns the largest number of bytes the given number of characters can decode to, whatever whitespace or padding they hold
+        size_t DecodedLengthUpperBound(size_t inputLength)
+        {
+            return Base64EncodingCore<true>::DecodedLengthUpperBound(inputLength);
+        }
+
+        // Converts a ASCII string into a Base64 string
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
+        int64_t Encode(char* pInputBuffer, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Instrumented(false, pInputBuffer, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::Encode(Alphabet, Kernel, pInputBuffer, pOutputBuffer, outputBufferLength)
+                                  : Base64EncodingCore<false>::Encode(Alphabet, Kernel, pInputBuffer, pOutputBuffer, outputBufferLength);
+            });
+        }
+
+        // Converts binary data of the given length into a Base64 string
+        // The input may contain null bytes and the output is not null terminated
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
+        int64_t Encode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Instrumented(false, inputLength, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::Encode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength)
+                                  : Base64EncodingCore<false>::Encode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+            });
+        }
+
+        // Converts binary data of the given length into a Base64 string broken into lines of the given length, such as 76 for MIME or 64 for PEM
+        // Line breaks are written in the same pass as the encoded characters, between lines and not after the final one
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
+        int64_t Encode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength, size_t lineLength, Base64LineBreak lineBreak)
+        {
+            return Instrumented(false, inputLength, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::Encode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength, lineLength, lineBreak)
+                                  : Base64EncodingCore<false>::Encode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength, lineLength, lineBreak);
+            });
+        }
+
+        // Converts binary data of the given length into a Base64 string in a single call, or measures it if it does not fit, as snprintf does
+        // The output is not null terminated
+        // Returns the length of the encoded string, written only if it is no longer than the output buffer, so a longer result is the length to reserve
+        // before calling again, or BASE64ENCODING_BUFFER_OVERFLOW if the length exceeds the range of a size_t
+        int64_t TryEncode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            int64_t result = BASE64ENCODING_INVALID_ALPHABET;
+
+            // Recorded as an overflow when only measured
+            Instrumented(false, inputLength, [&]
+            {
+                result = IsPadded() ? Base64EncodingCore<true>::TryEncode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength)
+                                    : Base64EncodingCore<false>::TryEncode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+
+                return result >= 0 && (size_t)result > outputBufferLength ? (int64_t)BASE64ENCODING_BUFFER_OVERFLOW : result;
+            });
+
+            return result;
+        }
+
+        // Converts binary data of the given length at the start of the buffer into a Base64 string written over the same buffer
+        // The buffer must hold EncodedLength(inputLength) characters, and the output is not null terminated
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the buffer is not large enough to hold the encoded string
+        int64_t EncodeInPlace(char* pBuffer, size_t inputLength, size_t bufferLength)
+        {
+            return Instrumented(false, inputLength, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::EncodeInPlace(Alphabet, Kernel, pBuffer, inputLength, bufferLength)
+                                  : Base64EncodingCore<false>::EncodeInPlace(Alphabet, Kernel, pBuffer, inputLength, bufferLength);
+            });
+        }
+
+        // Converts a Base64 string into a ASCII string
+        // Returns the length of the decoded string, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded string
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        int64_t Decode(char* pInputBuffer, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Instrumented(true, pInputBuffer, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::Decode(Alphabet, Kernel, pInputBuffer, pOutputBuffer, outputBufferLength)
+                                  : Base64EncodingCore<false>::Decode(Alphabet, Kernel, pInputBuffer, pOutputBuffer, outputBufferLength);
+            });
+        }
+
+        // Converts a Base64 string of the given length into binary data
+        // The input does not need to be null terminated and the output is not null terminated
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        int64_t Decode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Instrumented(true, inputLength, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::Decode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength)
+                                  : Base64EncodingCore<false>::Decode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+            });
+        }
+
+        // Converts a Base64 string of the given length into binary data in a single call, or measures it if it does not fit, as snprintf does
+        // The input does not need to be null terminated and is read once, and the output is not null terminated
+        // Returns the length of the decoded data, written only if it is no longer than the output buffer, so a longer result is the length to reserve
+        // before calling again, or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet, which is only checked as it is decoded
+        int64_t TryDecode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            int64_t result = BASE64ENCODING_INVALID_ALPHABET;
+
+            // Recorded as an overflow when only measured
+            Instrumented(true, inputLength, [&]
+            {
+                result = IsPadded() ? Base64EncodingCore<true>::TryDecode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength)
+                                    : Base64EncodingCore<false>::TryDecode(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+
+                return result >= 0 && (size_t)result > outputBufferLength ? (int64_t)BASE64ENCODING_BUFFER_OVERFLOW : result;
+            });
+
+            return result;
+        }
+
+        // Converts a Base64 string of the given length into binary data, skipping spaces, tabs, carriage returns and line feeds anywhere in it
+        // Suits MIME and PEM bodies, whose fixed length lines are decoded almost as fast as unbroken input
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        int64_t DecodeIgnoringWhitespace(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            return Instrumented(true, inputLength, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::DecodeIgnoringWhitespace(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength)
+                                  : Base64EncodingCore<false>::DecodeIgnoringWhitespace(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+            });
+        }
+
+        // Converts the Base64 string at the start of a larger buffer into binary data, stopping at the terminator or the end of the buffer
+        // Suits strings inside JSON documents, whose escaped solidus "\/" is decoded as '/' and whose closing quote is the terminator,
+        // so a parser can decode a field straight from the document into its final destination without copying or terminating it first
+        // Returns the length of the decoded data and sets the number of characters consumed, including the terminator if found,
+        // BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the string contains a character outside the alphabet or any other escape
+        int64_t DecodeDelimited(const char* pInputBuffer, size_t inputLength, char terminator, uint8_t* pOutputBuffer, size_t outputBufferLength, size_t& consumedLength)
+        {
+            return Instrumented(true, inputLength, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::DecodeDelimited(Alphabet, Kernel, pInputBuffer, inputLength, terminator, pOutputBuffer, outputBufferLength, consumedLength)
+                                  : Base64EncodingCore<false>::DecodeDelimited(Alphabet, Kernel, pInputBuffer, inputLength, terminator, pOutputBuffer, outputBufferLength, consumedLength);
+            });
+        }
+
+        // Converts a Base64 string of the given length into binary data, rejecting any input that is not exactly what Encode produces
+        // Reports invalid characters, misplaced or excess padding, lengths no encoding produces and non-zero bits beyond the final byte,
+        // along with the offset of the first byte at fault
+        Base64DecodeResult DecodeStrict(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            Base64DecodeResult result = { Base64DecodeStatus::Base64DecodeInvalidAlphabet, 0, 0 };
+
+            // Recorded with the error code Decode would return, any rejected input counting as invalid
+            Instrumented(true, inputLength, [&]
+            {
+                result = IsPadded() ? Base64EncodingCore<true>::DecodeStrict(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength)
+                                    : Base64EncodingCore<false>::DecodeStrict(Alphabet, Kernel, pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+
+                return result.Status == Base64DecodeStatus::Base64DecodeSucceeded ? (int64_t)result.BytesWritten
+                     : result.Status == Base64DecodeStatus::Base64DecodeOutputBufferOverflow ? (int64_t)BASE64ENCODING_BUFFER_OVERFLOW : (int64_t)BASE64ENCODING_INVALID_CHARACTER;
+            });
+
+            return result;
+        }
+
+        // Converts a Base64 string into a ASCII string written over the start of the same buffer
+        // Returns the length of the decoded string or BASE64ENCODING_INVALID_CHARACTER, in which case the buffer contents are unspecified
+        int64_t DecodeInPlace(char* pBuffer)
+        {
+            return Instrumented(true, pBuffer, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::DecodeInPlace(Alphabet, Kernel, pBuffer)
+                                  : Base64EncodingCore<false>::DecodeInPlace(Alphabet, Kernel, pBuffer);
+            });
+        }
+
+        // Converts a Base64 string of the given length into binary data written over the start of the same buffer
+        // Halves the memory needed compared to Decode, since the decoded data is always shorter than the Base64 string
+        // Returns the length of the decoded data or BASE64ENCODING_INVALID_CHARACTER, in which case the buffer contents are unspecified
+        int64_t DecodeInPlace(char* pBuffer, size_t length)
+        {
+            return Instrumented(true, length, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::DecodeInPlace(Alphabet, Kernel, pBuffer, length)
+                                  : Base64EncodingCore<false>::DecodeInPlace(Alphabet, Kernel, pBuffer, length);
+            });
+        }
+
+        // Returns the total length of the Base64 strings the items of a batch encode to, or BASE64ENCODING_LENGTH_OVERFLOW if it exceeds the range of a size_t
+        size_t EncodedBatchLength(const Base64BatchItem* pItems, size_t itemCount)
+        {
+            return IsPadded() ? Base64EncodingCore<true>::EncodedBatchLength(pItems, itemCount) : Base64EncodingCore<false>::EncodedBatchLength(pItems, itemCount);
+        }
+
+        // Returns the total length of the data the Base64 strings of a batch decode to
+        size_t DecodedBatchLength(const Base64BatchItem* pItems, size_t itemCount)
+        {
+            return IsPadded() ? Base64EncodingCore<true>::DecodedBatchLength(pItems, itemCount) : Base64EncodingCore<false>::DecodedBatchLength(pItems, itemCount);
+        }
+
+        // Converts many short inputs, such as session identifiers or token segments, into Base64 strings in one call
+        // The strings are written one after another into a single output buffer, with item i at [pOffsets[i], pOffsets[i + 1]), so the offsets array holds itemCount + 1 entries
+        // Returns the total length of the encoded strings or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold them
+        int64_t EncodeBatch(const Base64BatchItem* pItems, size_t itemCount, char* pOutputBuffer, size_t outputBufferLength, size_t* pOffsets)
+        {
+            return Instrumented(false, pItems, itemCount, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::EncodeBatch(Alphabet, Kernel, pItems, itemCount, pOutputBuffer, outputBufferLength, pOffsets)
+                                  : Base64EncodingCore<false>::EncodeBatch(Alphabet, Kernel, pItems, itemCount, pOutputBuffer, outputBufferLength, pOffsets);
+            });
+        }
+
+        // Converts many short Base64 strings into binary data in one call, written one after another into a single output buffer
+        // Item i is decoded to [pOffsets[i], pOffsets[i + 1]), so the offsets array holds itemCount + 1 entries
+        // Returns the total length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold it
+        // or BASE64ENCODING_INVALID_CHARACTER if an item contains a character outside the alphabet
+        int64_t DecodeBatch(const Base64BatchItem* pItems, size_t itemCount, uint8_t* pOutputBuffer, size_t outputBufferLength, size_t* pOffsets)
+        {
+            return Instrumented(true, pItems, itemCount, [&]
+            {
+                return IsPadded() ? Base64EncodingCore<true>::DecodeBatch(Alphabet, Kernel, pItems, itemCount, pOutputBuffer, outputBufferLength, pOffsets)
+                                  : Base64EncodingCore<false>::DecodeBatch(Alphabet, Kernel, pItems, itemCount, pOutputBuffer, outputBufferLength, pOffsets);
+            });
         }
 };
 
-#endif // Base64Encoding_h
\ No newline at end of file
+#endif // Base64Encoding_h
@@ -0,0 +1,343 @@
+#ifndef Base64EncodingChecksum_h
+#define Base64EncodingChecksum_h
+
+#include "Base64Encoding.hpp"
+
+// Number of bytes of binary data encoded or decoded at a time by Base64ChecksumEncoding, a whole number of groups
+// The block and its Base64 text together stay well within the level 1 data cache, so the checksum reads the bytes the codec has just touched
+#define BASE64ENCODING_CHECKSUM_BLOCK_LENGTH 6144
+
+// Table for the bytewise CRC-32C, built at compile time
+struct Base64Crc32cTable
+{
+    uint32_t Entries[256];
+
+    constexpr Base64Crc32cTable()
+      : Entries()
+    {
+        for(uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+
+            for(int bit = 0; bit < 8; bit++)
+            {
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78 : crc >> 1;
+            }
+
+            Entries[i] = crc;
+        }
+    }
+};
+
+// Running CRC-32C (Castagnoli), as used by iSCSI, ext4 and many storage and network formats
+// Uses the SSE4.2 CRC32 instruction where the processor has it
+class Base64Crc32c
+{
+    private:
+
+        static constexpr Base64Crc32cTable Table = Base64Crc32cTable();
+
+        uint32_t State;
+
+    public:
+
+        Base64Crc32c()
+          : State(0xFFFFFFFF)
+        {
+
+        }
+
+        void Update(const void* pData, size_t length)
+        {
+            const uint8_t* pBytes = (const uint8_t*)pData;
+
+#ifdef BASE64ENCODING_X86
+            if(Base64EncodingSimd::SupportsCrc32())
+            {
+                State = Base64EncodingSimd::Crc32cSse42(State, pBytes, length);
+
+                return;
+            }
+#endif
+
+            for(size_t i = 0; i < length; i++)
+            {
+                State = Table.Entries[(State ^ pBytes[i]) & 0xFF] ^ (State >> 8);
+            }
+        }
+
+        // Returns the checksum of every byte passed to Update so far
+        uint32_t Digest() const
+        {
+            return ~State;
+        }
+};
+
+// Running 64-bit xxHash (XXH64)
+class Base64XxHash64
+{
+    private:
+
+        static constexpr uint64_t Prime1 = 11400714785074694791ULL;
+        static constexpr uint64_t Prime2 = 14029467366897019727ULL;
+        static constexpr uint64_t Prime3 = 1609587929392839161ULL;
+        static constexpr uint64_t Prime4 = 9650029242287828579ULL;
+        static constexpr uint64_t Prime5 = 2870177450012600261ULL;
+
+        uint64_t Seed;
+        uint64_t Accumulators[4];
+
+        // Bytes left over from the last update, short of a whole 32-byte stripe
+        uint8_t Stripe[32];
+        size_t StripeLength;
+
+        uint64_t TotalLength;
+
+        static uint64_t RotateLeft(uint64_t value, int count)
+        {
+            return (value << count) | (value >> (64 - count));
+        }
+
+        static uint64_t Read64(const uint8_t* pData)
+        {
+            uint64_t value;
+            memcpy(&value, pData, 8);
+
+            return value;
+        }
+
+        static uint32_t Read32(const uint8_t* pData)
+        {
+            uint32_t value;
+            memcpy(&value, pData, 4);
+
+            return value;
+        }
+
+        static uint64_t Round(uint64_t accumulator, uint64_t input)
+        {
+            accumulator += input * Prime2;
+            accumulator = RotateLeft(accumulator, 31);
+
+            return accumulator * Prime1;
+        }
+
+        static uint64_t MergeRound(uint64_t hash, uint64_t accumulator)
+        {
+            hash ^= Round(0, accumulator);
+
+            return hash * Prime1 + Prime4;
+        }
+
+        // Consumes whole stripes and returns the number of bytes consumed
+        size_t ConsumeStripes(const uint8_t* pData, size_t length)
+        {
+            uint64_t accumulator1 = Accumulators[0];
+            uint64_t accumulator2 = Accumulators[1];
+            uint64_t accumulator3 = Accumulators[2];
+            uint64_t accumulator4 = Accumulators[3];
+            size_t offset = 0;
+
+            for(; offset + 32 <= length; offset += 32)
+            {
+                accumulator1 = Round(accumulator1, Read64(pData + offset));
+                accumulator2 = Round(accumulator2, Read64(pData + offset + 8));
+                accumulator3 = Round(accumulator3, Read64(pData + offset + 16));
+                accumulator4 = Round(accumulator4, Read64(pData + offset + 24));
+            }
+
+            Accumulators[0] = accumulator1;
+            Accumulators[1] = accumulator2;
+            Accumulators[2] = accumulator3;
+            Accumulators[3] = accumulator4;
+
+            return offset;
+        }
+
+    public:
+
+        Base64XxHash64(uint64_t seed = 0)
+          : Seed(seed),
+            Accumulators{ seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1 },
+            Stripe(),
+            StripeLength(0),
+            TotalLength(0)
+        {
+
+        }
+
+        void Update(const void* pData, size_t length)
+        {
+            const uint8_t* pBytes = (const uint8_t*)pData;
+
+            TotalLength += length;
+
+            // Complete the stripe left over from the last update first
+            if(StripeLength > 0)
+            {
+                size_t copyLength = length < 32 - StripeLength ? length : 32 - StripeLength;
+
+                memcpy(Stripe + StripeLength, pBytes, copyLength);
+                StripeLength += copyLength;
+                pBytes += copyLength;
+                length -= copyLength;
+
+                if(StripeLength < 32)
+                {
+                    return;
+                }
+
+                ConsumeStripes(Stripe, 32);
+                StripeLength = 0;
+            }
+
+            size_t consumed = ConsumeStripes(pBytes, length);
+
+            memcpy(Stripe, pBytes + consumed, length - consumed);
+            StripeLength = length - consumed;
+        }
+
+        // Returns the hash of every byte passed to Update so far
+        uint64_t Digest() const
+        {
+            uint64_t hash;
+
+            if(TotalLength >= 32)
+            {
+                hash = RotateLeft(Accumulators[0], 1) + RotateLeft(Accumulators[1], 7) + RotateLeft(Accumulators[2], 12) + RotateLeft(Accumulators[3], 18);
+
+                for(int i = 0; i < 4; i++)
+                {
+                    hash = MergeRound(hash, Accumulators[i]);
+                }
+            }
+            else
+            {
+                hash = Seed + Prime5;
+            }
+
+            hash += TotalLength;
+
+            size_t offset = 0;
+
+            for(; offset + 8 <= StripeLength; offset += 8)
+            {
+                hash ^= Round(0, Read64(Stripe + offset));
+                hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+            }
+
+            if(offset + 4 <= StripeLength)
+            {
+                hash ^= (uint64_t)Read32(Stripe + offset) * Prime1;
+                hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+                offset += 4;
+            }
+
+            for(; offset < StripeLength; offset++)
+            {
+                hash ^= Stripe[offset] * Prime5;
+                hash = RotateLeft(hash, 11) * Prime1;
+            }
+
+            hash ^= hash >> 33;
+            hash *= Prime2;
+            hash ^= hash >> 29;
+            hash *= Prime3;
+            hash ^= hash >> 32;
+
+            return hash;
+        }
+};
+
+// Encodes and decodes while computing running checksums of the binary data in the same pass over memory
+// Works through the data a block at a time, checksumming each block while it is still in the level 1 data cache, rather than reading the whole output again afterwards
+// Any number of checksums can be computed at once, of any type with an Update(const void* pData, size_t length) member such as Base64Crc32c or Base64XxHash64
+class Base64ChecksumEncoding
+{
+    private:
+
+        Base64Encoding& Encoding;
+
+    public:
+
+        Base64ChecksumEncoding(Base64Encoding& encoding)
+          : Encoding(encoding)
+        {
+
+        }
+
+        // Converts binary data of the given length into a Base64 string, updating each checksum with the binary data
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string,
+        // in which case the checksums are left unchanged
+        template<typename... TChecksums>
+        int64_t Encode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength, TChecksums&... checksums)
+        {
+            // Blocks are encoded without checking each result, so an encoding that rejects every call is caught first
+            if(!Encoding.IsValid())
+            {
+                return BASE64ENCODING_INVALID_ALPHABET;
+            }
+
+            size_t encodedLength = Encoding.EncodedLength(inputLength);
+
+            // Verify the output buffer is large enough to hold the encoded string
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || outputBufferLength < encodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            for(size_t offset = 0; offset < inputLength; offset += BASE64ENCODING_CHECKSUM_BLOCK_LENGTH)
+            {
+                size_t blockLength = inputLength - offset < BASE64ENCODING_CHECKSUM_BLOCK_LENGTH ? inputLength - offset : BASE64ENCODING_CHECKSUM_BLOCK_LENGTH;
+                size_t outputOffset = (offset / 3) * 4;
+
+                (checksums.Update(pInputBuffer + offset, blockLength), ...);
+
+                Encoding.Encode(pInputBuffer + offset, blockLength, pOutputBuffer + outputOffset, encodedLength - outputOffset);
+            }
+
+            return (int64_t)encodedLength;
+        }
+
+        // Converts a Base64 string of the given length into binary data, updating each checksum with the decoded data
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet or padding before its end,
+        // in which case the checksums hold part of the data and should be discarded
+        template<typename... TChecksums>
+        int64_t Decode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength, TChecksums&... checksums)
+        {
+            size_t decodedLength = Encoding.DecodedLength(pInputBuffer, inputLength);
+            size_t blockInputLength = (BASE64ENCODING_CHECKSUM_BLOCK_LENGTH / 3) * 4;
+
+            // Verify the output buffer is large enough to hold the decoded data
+            if(outputBufferLength < decodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            for(size_t offset = 0; offset < inputLength; offset += blockInputLength)
+            {
+                bool finalBlock = inputLength - offset <= blockInputLength;
+                size_t outputOffset = (offset / 4) * 3;
+                int64_t blockDecodedLength = Encoding.Decode(pInputBuffer + offset, finalBlock ? inputLength - offset : blockInputLength, pOutputBuffer + outputOffset, outputBufferLength - outputOffset);
+
+                if(blockDecodedLength < 0)
+                {
+                    return blockDecodedLength;
+                }
+
+                // Padding ends the string, so every block before the final one decodes to a whole block,
+                // and the final one to the rest of the length measured for the whole string unless its tail is malformed
+                if(finalBlock ? outputOffset + (size_t)blockDecodedLength != decodedLength : blockDecodedLength != BASE64ENCODING_CHECKSUM_BLOCK_LENGTH)
+                {
+                    return BASE64ENCODING_INVALID_CHARACTER;
+                }
+
+                (checksums.Update(pOutputBuffer + outputOffset, (size_t)blockDecodedLength), ...);
+            }
+
+            return (int64_t)decodedLength;
+        }
+};
+
+#endif // Base64EncodingChecksum_h
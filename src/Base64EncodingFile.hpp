@@ -0,0 +1,316 @@
+#ifndef Base64EncodingFile_h
+#define Base64EncodingFile_h
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Base64EncodingParallel.hpp"
+
+// Returned when a file cannot be opened, sized or mapped, with errno describing the cause
+#define BASE64ENCODING_FILE_ERROR -3
+
+// Number of pages in each window of a file mapped at once, multiplied by three for binary data and by four for Base64 text
+// With 4 KB pages, windows are 48 MB of binary data and 64 MB of Base64 text
+#define BASE64ENCODING_FILE_WINDOW_PAGES 4096
+
+// Encodes and decodes files on POSIX systems through memory mappings, with no intermediate buffers or read and write copies
+// The output file is sized up front and both files are mapped a window at a time, so memory use is bounded whatever the file size,
+// while every window is split across the threads of a Base64ParallelEncoding
+class Base64FileEncoding
+{
+    private:
+
+        Base64Encoding& Encoding;
+        Base64ParallelEncoding ParallelEncoding;
+
+        size_t WindowPageCount;
+
+        // Maps the given range of a file, hinting that it will be accessed sequentially
+        // Returns NULL if the range cannot be mapped
+        static uint8_t* MapWindow(int file, size_t offset, size_t length, bool writable)
+        {
+            void* pWindow = mmap(NULL, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, (off_t)offset);
+
+            if(pWindow == MAP_FAILED)
+            {
+                return NULL;
+            }
+
+            madvise(pWindow, length, MADV_SEQUENTIAL);
+
+            return (uint8_t*)pWindow;
+        }
+
+        // Returns the length of the file, or BASE64ENCODING_FILE_ERROR if it cannot be determined
+        static int64_t FileLength(int file)
+        {
+            struct stat fileStatus;
+
+            if(fstat(file, &fileStatus) != 0)
+            {
+                return BASE64ENCODING_FILE_ERROR;
+            }
+
+            return (int64_t)fileStatus.st_size;
+        }
+
+        // Returns the length of the Base64 text in the file once trailing line breaks and spaces are left out, as most tools end the text with a line break
+        static size_t TrimmedLength(int file, size_t fileLength)
+        {
+            char tail[64];
+
+            while(fileLength > 0)
+            {
+                size_t tailLength = fileLength < sizeof(tail) ? fileLength : sizeof(tail);
+
+                if(pread(file, tail, tailLength, (off_t)(fileLength - tailLength)) != (ssize_t)tailLength)
+                {
+                    return fileLength;
+                }
+
+                size_t trimmedLength = tailLength;
+
+                while(trimmedLength > 0 && (tail[trimmedLength - 1] == '\n' || tail[trimmedLength - 1] == '\r' || tail[trimmedLength - 1] == ' ' || tail[trimmedLength - 1] == '\t'))
+                {
+                    trimmedLength--;
+                }
+
+                fileLength -= tailLength - trimmedLength;
+
+                if(trimmedLength > 0)
+                {
+                    break;
+                }
+            }
+
+            return fileLength;
+        }
+
+        // Returns the length of the data the Base64 text of the given length at the start of the file decodes to, or BASE64ENCODING_FILE_ERROR
+        // Only the final characters can hold padding, so they alone are read
+        int64_t DecodedFileLength(int file, size_t inputLength)
+        {
+            char tail[8];
+
+            // Every whole group before the tail decodes to three bytes
+            size_t groupedLength = inputLength > sizeof(tail) ? ((inputLength - sizeof(tail) + 3) / 4) * 4 : 0;
+            size_t tailLength = inputLength - groupedLength;
+
+            ssize_t readLength = pread(file, tail, tailLength, (off_t)groupedLength);
+
+            if(readLength != (ssize_t)tailLength)
+            {
+                // A short read sets no errno, and means the file shrank after it was sized
+                if(readLength >= 0)
+                {
+                    errno = EIO;
+                }
+
+                return BASE64ENCODING_FILE_ERROR;
+            }
+
+            return (int64_t)((groupedLength / 4) * 3 + Encoding.DecodedLength(tail, tailLength));
+        }
+
+        // Creates or truncates the output file and sizes it to the given length
+        // Returns the open file, or -1 if it cannot be created or sized
+        static int CreateOutputFile(const char* pOutputPath, size_t outputLength)
+        {
+            int outputFile = open(pOutputPath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+            if(outputFile >= 0 && ftruncate(outputFile, (off_t)outputLength) != 0)
+            {
+                close(outputFile);
+
+                return -1;
+            }
+
+            return outputFile;
+        }
+
+        // Converts the input file into the output file a window at a time, with windows of the given lengths at matching offsets in each file
+        // Returns the length of the output, BASE64ENCODING_INVALID_CHARACTER if decoding rejects the input or its length, in which case the output file is left empty,
+        // or BASE64ENCODING_FILE_ERROR
+        int64_t ConvertFile(int inputFile, size_t inputLength, const char* pOutputPath, size_t outputLength, size_t inputWindowLength, size_t outputWindowLength, bool decoding)
+        {
+            // Checked before the output file is created or replaced
+            if(!Encoding.IsValid())
+            {
+                return BASE64ENCODING_INVALID_ALPHABET;
+            }
+
+            int outputFile = CreateOutputFile(pOutputPath, outputLength);
+
+            if(outputFile < 0)
+            {
+                return BASE64ENCODING_FILE_ERROR;
+            }
+
+            int64_t result = (int64_t)outputLength;
+
+            // Text whose length leaves characters over, which decoding would drop, is rejected before any window is decoded
+            if(decoding && !Encoding.IsValidLength(inputLength))
+            {
+                result = BASE64ENCODING_INVALID_CHARACTER;
+            }
+
+            for(size_t window = 0; result >= 0 && window * inputWindowLength < inputLength; window++)
+            {
+                size_t inputOffset = window * inputWindowLength;
+                size_t outputOffset = window * outputWindowLength;
+                size_t windowInputLength = inputLength - inputOffset < inputWindowLength ? inputLength - inputOffset : inputWindowLength;
+                size_t windowOutputLength = outputLength - outputOffset < outputWindowLength ? outputLength - outputOffset : outputWindowLength;
+
+                uint8_t* pInputWindow = MapWindow(inputFile, inputOffset, windowInputLength, false);
+                uint8_t* pOutputWindow = windowOutputLength > 0 ? MapWindow(outputFile, outputOffset, windowOutputLength, true) : NULL;
+
+                if(pInputWindow == NULL || (windowOutputLength > 0 && pOutputWindow == NULL))
+                {
+                    result = BASE64ENCODING_FILE_ERROR;
+                }
+                else if(decoding)
+                {
+                    // Padding is only valid at the end of the final window
+                    if(inputOffset + windowInputLength < inputLength && pInputWindow[windowInputLength - 1] == '=')
+                    {
+                        result = BASE64ENCODING_INVALID_CHARACTER;
+                    }
+                    else
+                    {
+                        int64_t windowResult = ParallelEncoding.Decode((const char*)pInputWindow, windowInputLength, pOutputWindow, windowOutputLength);
+
+                        if(windowResult < 0)
+                        {
+                            result = windowResult;
+                        }
+                    }
+                }
+                else
+                {
+                    ParallelEncoding.Encode(pInputWindow, windowInputLength, (char*)pOutputWindow, windowOutputLength);
+                }
+
+                if(pInputWindow != NULL)
+                {
+                    munmap(pInputWindow, windowInputLength);
+                }
+
+                if(pOutputWindow != NULL)
+                {
+                    munmap(pOutputWindow, windowOutputLength);
+                }
+
+                if(result < 0)
+                {
+                    break;
+                }
+            }
+
+            // Leave no partial output behind rejected input
+            if(result == BASE64ENCODING_INVALID_CHARACTER && ftruncate(outputFile, 0) != 0)
+            {
+                result = BASE64ENCODING_FILE_ERROR;
+            }
+
+            if(close(outputFile) != 0 && result >= 0)
+            {
+                result = BASE64ENCODING_FILE_ERROR;
+            }
+
+            return result;
+        }
+
+    public:
+
+        // Uses a thread pool owned by this object, with a thread for every hardware thread
+        Base64FileEncoding(Base64Encoding& encoding)
+          : Encoding(encoding),
+            ParallelEncoding(encoding),
+            WindowPageCount(BASE64ENCODING_FILE_WINDOW_PAGES)
+        {
+
+        }
+
+        // Uses a thread pool provided by the caller, which must outlive this object
+        Base64FileEncoding(Base64Encoding& encoding, Base64ThreadPool& threadPool)
+          : Encoding(encoding),
+            ParallelEncoding(encoding, threadPool),
+            WindowPageCount(BASE64ENCODING_FILE_WINDOW_PAGES)
+        {
+
+        }
+
+        // Sets the number of pages in each window, so that windows are three times as many pages of binary data and four times as many of Base64 text
+        void SetWindowPageCount(size_t windowPageCount)
+        {
+            WindowPageCount = windowPageCount > 0 ? windowPageCount : 1;
+        }
+
+        // Converts the binary data in the input file into a Base64 string written to the output file, which is created or replaced
+        // The output is not null terminated and has no line breaks
+        // Returns the length of the encoded string or BASE64ENCODING_FILE_ERROR, with errno describing the cause
+        int64_t EncodeFile(const char* pInputPath, const char* pOutputPath)
+        {
+            int inputFile = open(pInputPath, O_RDONLY);
+
+            if(inputFile < 0)
+            {
+                return BASE64ENCODING_FILE_ERROR;
+            }
+
+            int64_t inputLength = FileLength(inputFile);
+            int64_t result = BASE64ENCODING_FILE_ERROR;
+
+            if(inputLength >= 0)
+            {
+                size_t outputLength = Encoding.EncodedLength((size_t)inputLength);
+
+                // Windows of whole pages and whole groups in both files keep every mapping offset page aligned
+                size_t pageLength = (size_t)sysconf(_SC_PAGESIZE);
+
+                result = ConvertFile(inputFile, (size_t)inputLength, pOutputPath, outputLength, 3 * WindowPageCount * pageLength, 4 * WindowPageCount * pageLength, false);
+            }
+
+            close(inputFile);
+
+            return result;
+        }
+
+        // Converts the Base64 string in the input file into binary data written to the output file, which is created or replaced
+        // Trailing line breaks and spaces are ignored, but the string must not otherwise be broken into lines
+        // Returns the length of the decoded data, BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet,
+        // in which case the output file is left empty, or BASE64ENCODING_FILE_ERROR, with errno describing the cause
+        int64_t DecodeFile(const char* pInputPath, const char* pOutputPath)
+        {
+            int inputFile = open(pInputPath, O_RDONLY);
+
+            if(inputFile < 0)
+            {
+                return BASE64ENCODING_FILE_ERROR;
+            }
+
+            int64_t fileLength = FileLength(inputFile);
+            int64_t result = BASE64ENCODING_FILE_ERROR;
+
+            if(fileLength >= 0)
+            {
+                size_t inputLength = TrimmedLength(inputFile, (size_t)fileLength);
+                int64_t outputLength = DecodedFileLength(inputFile, inputLength);
+                size_t pageLength = (size_t)sysconf(_SC_PAGESIZE);
+
+                if(outputLength >= 0)
+                {
+                    result = ConvertFile(inputFile, inputLength, pOutputPath, (size_t)outputLength, 4 * WindowPageCount * pageLength, 3 * WindowPageCount * pageLength, true);
+                }
+            }
+
+            close(inputFile);
+
+            return result;
+        }
+};
+
+#endif // Base64EncodingFile_h
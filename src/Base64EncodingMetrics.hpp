@@ -0,0 +1,408 @@
+#ifndef Base64EncodingMetrics_h
+#define Base64EncodingMetrics_h
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "Base64EncodingSimd.hpp"
+
+// Included by Base64Encoding.hpp when BASE64ENCODING_INSTRUMENTATION is defined, once the error codes it counts are defined
+
+// Number of buckets in the input size histogram
+// Bucket b counts inputs of at least 2^(b - 1) and less than 2^b bytes, bucket 0 counts empty inputs and the last bucket every larger input
+#define BASE64ENCODING_METRICS_SIZE_BUCKETS 33
+
+// Each thread times one call in this many, as reading the timestamp counter can cost more than encoding a short input
+#define BASE64ENCODING_METRICS_TIMING_INTERVAL 16
+
+// Number of kernels and operations counters are kept for
+#define BASE64ENCODING_METRICS_KERNELS (Base64EncodingKernel::Base64KernelAvx512Vbmi + 1)
+#define BASE64ENCODING_METRICS_OPERATIONS 2
+
+// Operation a call to Base64Encoding is counted under
+// The decode variants, such as DecodeStrict and DecodeIgnoringWhitespace, count as decodes and a batch counts as a single call
+typedef enum
+{
+    Base64MetricsEncoding = 0,
+    Base64MetricsDecoding = 1
+} Base64MetricsOperation;
+
+// Totals for one operation with one kernel
+struct Base64OperationMetrics
+{
+    uint64_t Calls;
+    uint64_t InputBytes;
+
+    // Bytes written by successful calls
+    uint64_t OutputBytes;
+
+    uint64_t BufferOverflows;
+
+    // Decodes rejected because of their input, whether for an invalid character or, with DecodeStrict, invalid padding, length or trailing bits
+    uint64_t InvalidInputs;
+
+    // Calls that were timed, their input and the time they took, in processor timestamp counter cycles on x86 and nanoseconds elsewhere
+    uint64_t TimedCalls;
+    uint64_t TimedInputBytes;
+    uint64_t Cycles;
+
+    uint64_t SizeHistogram[BASE64ENCODING_METRICS_SIZE_BUCKETS];
+
+    double CyclesPerByte() const
+    {
+        return TimedInputBytes > 0 ? (double)Cycles / (double)TimedInputBytes : 0;
+    }
+};
+
+// Totals for every operation and kernel, indexed as Operations[operation][kernel]
+struct Base64MetricsSnapshot
+{
+    Base64OperationMetrics Operations[BASE64ENCODING_METRICS_OPERATIONS][BASE64ENCODING_METRICS_KERNELS];
+};
+
+// A single call, passed to the trace hook as it returns
+struct Base64TraceEvent
+{
+    Base64MetricsOperation Operation;
+    Base64EncodingKernel Kernel;
+    size_t InputLength;
+
+    // Value returned by the call, the output length or a negative error code
+    int64_t Result;
+
+    // Every call is timed while a trace hook is set, except one already under way when it was set, which reports zero
+    uint64_t Cycles;
+};
+
+typedef void (*Base64TraceHook)(const Base64TraceEvent& event);
+
+// Receives the counters of a snapshot, for forwarding to a metrics system
+// Only operations and kernels that have been called at least once are exported
+class Base64MetricsExporter
+{
+    public:
+
+        virtual ~Base64MetricsExporter()
+        {
+
+        }
+
+        // Receives one counter, named in snake case such as "input_bytes"
+        virtual void ExportCounter(const char* pName, Base64MetricsOperation operation, Base64EncodingKernel kernel, uint64_t value) = 0;
+
+        // Receives the input size histogram, with the buckets described by BASE64ENCODING_METRICS_SIZE_BUCKETS
+        virtual void ExportHistogram(const char* pName, Base64MetricsOperation operation, Base64EncodingKernel kernel, const uint64_t* pBuckets, size_t bucketCount) = 0;
+};
+
+// Process wide counters of the calls made through Base64Encoding, which must be built with BASE64ENCODING_INSTRUMENTATION defined the same way in every translation unit
+// Without it this header is not included and Base64Encoding makes its calls directly
+// Parallel, stream, file and sink front ends count the calls they make to Base64Encoding, such as one per chunk
+// Each thread counts into a shard of its own, on separate cache lines and written without atomic read-modify-write instructions,
+// and a snapshot sums the shards, so recording never contends between threads
+class Base64Metrics
+{
+    private:
+
+        struct Counters
+        {
+            std::atomic<uint64_t> Calls;
+            std::atomic<uint64_t> InputBytes;
+            std::atomic<uint64_t> OutputBytes;
+            std::atomic<uint64_t> BufferOverflows;
+            std::atomic<uint64_t> InvalidInputs;
+            std::atomic<uint64_t> TimedCalls;
+            std::atomic<uint64_t> TimedInputBytes;
+            std::atomic<uint64_t> Cycles;
+            std::atomic<uint64_t> SizeHistogram[BASE64ENCODING_METRICS_SIZE_BUCKETS];
+        };
+
+        struct alignas(64) Shard
+        {
+            Counters Operations[BASE64ENCODING_METRICS_OPERATIONS][BASE64ENCODING_METRICS_KERNELS];
+        };
+
+        // Shards of running threads, and the totals of threads that have exited
+        struct Registry
+        {
+            std::mutex Mutex;
+            std::vector<Shard*> Shards;
+            Base64MetricsSnapshot Retired;
+        };
+
+        // Registers a shard for the thread on its first recorded call, and folds it into the retired totals when the thread exits
+        class ThreadShard
+        {
+            public:
+
+                Shard* pShard;
+
+                ThreadShard()
+                  : pShard(new Shard())
+                {
+                    Registry& registry = GetRegistry();
+                    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+                    registry.Shards.push_back(pShard);
+                }
+
+                ~ThreadShard()
+                {
+                    Registry& registry = GetRegistry();
+                    std::lock_guard<std::mutex> lock(registry.Mutex);
+
+                    AddShard(*pShard, registry.Retired);
+                    registry.Shards.erase(std::find(registry.Shards.begin(), registry.Shards.end(), pShard));
+
+                    delete pShard;
+                }
+        };
+
+        // State of the calling thread, constant initialized so that reaching it needs no check for a first use
+        struct ThreadState
+        {
+            Shard* pShard;
+            uint32_t CallsUntilTimed;
+        };
+
+        static ThreadState& GetThreadState()
+        {
+            static thread_local ThreadState threadState = { NULL, 0 };
+
+            return threadState;
+        }
+
+        static Shard* RegisterThread()
+        {
+            static thread_local ThreadShard threadShard;
+
+            return threadShard.pShard;
+        }
+
+        static Registry& GetRegistry()
+        {
+            static Registry registry = Registry();
+
+            return registry;
+        }
+
+        static std::atomic<Base64TraceHook>& GetTraceHook()
+        {
+            static std::atomic<Base64TraceHook> traceHook(NULL);
+
+            return traceHook;
+        }
+
+        // Only the owning thread writes to a counter, so a plain load and store suffices
+        static void Add(std::atomic<uint64_t>& counter, uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        static void AddShard(const Shard& shard, Base64MetricsSnapshot& snapshot)
+        {
+            for(size_t operation = 0; operation < BASE64ENCODING_METRICS_OPERATIONS; operation++)
+            {
+                for(size_t kernel = 0; kernel < BASE64ENCODING_METRICS_KERNELS; kernel++)
+                {
+                    const Counters& counters = shard.Operations[operation][kernel];
+                    Base64OperationMetrics& metrics = snapshot.Operations[operation][kernel];
+
+                    metrics.Calls += counters.Calls.load(std::memory_order_relaxed);
+                    metrics.InputBytes += counters.InputBytes.load(std::memory_order_relaxed);
+                    metrics.OutputBytes += counters.OutputBytes.load(std::memory_order_relaxed);
+                    metrics.BufferOverflows += counters.BufferOverflows.load(std::memory_order_relaxed);
+                    metrics.InvalidInputs += counters.InvalidInputs.load(std::memory_order_relaxed);
+                    metrics.TimedCalls += counters.TimedCalls.load(std::memory_order_relaxed);
+                    metrics.TimedInputBytes += counters.TimedInputBytes.load(std::memory_order_relaxed);
+                    metrics.Cycles += counters.Cycles.load(std::memory_order_relaxed);
+
+                    for(size_t bucket = 0; bucket < BASE64ENCODING_METRICS_SIZE_BUCKETS; bucket++)
+                    {
+                        metrics.SizeHistogram[bucket] += counters.SizeHistogram[bucket].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+        static void ResetShard(Shard& shard)
+        {
+            for(size_t operation = 0; operation < BASE64ENCODING_METRICS_OPERATIONS; operation++)
+            {
+                for(size_t kernel = 0; kernel < BASE64ENCODING_METRICS_KERNELS; kernel++)
+                {
+                    Counters& counters = shard.Operations[operation][kernel];
+
+                    counters.Calls.store(0, std::memory_order_relaxed);
+                    counters.InputBytes.store(0, std::memory_order_relaxed);
+                    counters.OutputBytes.store(0, std::memory_order_relaxed);
+                    counters.BufferOverflows.store(0, std::memory_order_relaxed);
+                    counters.InvalidInputs.store(0, std::memory_order_relaxed);
+                    counters.TimedCalls.store(0, std::memory_order_relaxed);
+                    counters.TimedInputBytes.store(0, std::memory_order_relaxed);
+                    counters.Cycles.store(0, std::memory_order_relaxed);
+
+                    for(size_t bucket = 0; bucket < BASE64ENCODING_METRICS_SIZE_BUCKETS; bucket++)
+                    {
+                        counters.SizeHistogram[bucket].store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+
+    public:
+
+        // Returns the current time in the unit of Base64OperationMetrics::Cycles
+        static uint64_t Ticks()
+        {
+#ifdef BASE64ENCODING_X86
+            return (uint64_t)__rdtsc();
+#else
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        // Called before each call to be recorded
+        // Returns the time the call starts if it is to be timed, or zero
+        static uint64_t StartCall()
+        {
+            ThreadState& threadState = GetThreadState();
+
+            if(threadState.CallsUntilTimed == 0 || GetTraceHook().load(std::memory_order_relaxed) != NULL)
+            {
+                threadState.CallsUntilTimed = BASE64ENCODING_METRICS_TIMING_INTERVAL - 1;
+
+                return Ticks();
+            }
+
+            threadState.CallsUntilTimed--;
+
+            return 0;
+        }
+
+        // Counts a call in the shard of the calling thread and passes it to the trace hook, if one is set
+        // Result is the value the call returned, the output length or BASE64ENCODING_BUFFER_OVERFLOW, and any other negative value counts as invalid input
+        // Start is the value StartCall returned before the call
+        static void Record(Base64MetricsOperation operation, Base64EncodingKernel kernel, size_t inputLength, int64_t result, uint64_t start)
+        {
+            uint64_t cycles = start != 0 ? Ticks() - start : 0;
+            ThreadState& threadState = GetThreadState();
+
+            if(threadState.pShard == NULL)
+            {
+                threadState.pShard = RegisterThread();
+            }
+
+            Counters& counters = threadState.pShard->Operations[operation][kernel];
+            size_t bucket = 0;
+
+            while(bucket < BASE64ENCODING_METRICS_SIZE_BUCKETS - 1 && (inputLength >> bucket) != 0)
+            {
+                bucket++;
+            }
+
+            Add(counters.Calls, 1);
+            Add(counters.InputBytes, inputLength);
+            Add(counters.SizeHistogram[bucket], 1);
+
+            if(result >= 0)
+            {
+                Add(counters.OutputBytes, (uint64_t)result);
+            }
+            else if(result == BASE64ENCODING_BUFFER_OVERFLOW)
+            {
+                Add(counters.BufferOverflows, 1);
+            }
+            else
+            {
+                Add(counters.InvalidInputs, 1);
+            }
+
+            if(start != 0)
+            {
+                Add(counters.TimedCalls, 1);
+                Add(counters.TimedInputBytes, inputLength);
+                Add(counters.Cycles, cycles);
+            }
+
+            Base64TraceHook traceHook = GetTraceHook().load(std::memory_order_acquire);
+
+            if(traceHook != NULL)
+            {
+                traceHook({ operation, kernel, inputLength, result, cycles });
+            }
+        }
+
+        // Returns the totals of every thread, running or exited
+        static Base64MetricsSnapshot Snapshot()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+            Base64MetricsSnapshot snapshot = registry.Retired;
+
+            for(Shard* pShard : registry.Shards)
+            {
+                AddShard(*pShard, snapshot);
+            }
+
+            return snapshot;
+        }
+
+        // Sets every counter back to zero
+        // Calls recorded by other threads while the counters are reset may be partly kept
+        static void Reset()
+        {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.Mutex);
+
+            registry.Retired = Base64MetricsSnapshot();
+
+            for(Shard* pShard : registry.Shards)
+            {
+                ResetShard(*pShard);
+            }
+        }
+
+        // Passes a snapshot to the exporter, counter by counter
+        static void Export(Base64MetricsExporter& exporter)
+        {
+            Base64MetricsSnapshot snapshot = Snapshot();
+
+            for(size_t operation = 0; operation < BASE64ENCODING_METRICS_OPERATIONS; operation++)
+            {
+                for(size_t kernel = 0; kernel < BASE64ENCODING_METRICS_KERNELS; kernel++)
+                {
+                    const Base64OperationMetrics& metrics = snapshot.Operations[operation][kernel];
+                    Base64MetricsOperation metricsOperation = (Base64MetricsOperation)operation;
+                    Base64EncodingKernel metricsKernel = (Base64EncodingKernel)kernel;
+
+                    if(metrics.Calls == 0)
+                    {
+                        continue;
+                    }
+
+                    exporter.ExportCounter("calls", metricsOperation, metricsKernel, metrics.Calls);
+                    exporter.ExportCounter("input_bytes", metricsOperation, metricsKernel, metrics.InputBytes);
+                    exporter.ExportCounter("output_bytes", metricsOperation, metricsKernel, metrics.OutputBytes);
+                    exporter.ExportCounter("buffer_overflows", metricsOperation, metricsKernel, metrics.BufferOverflows);
+                    exporter.ExportCounter("invalid_inputs", metricsOperation, metricsKernel, metrics.InvalidInputs);
+                    exporter.ExportCounter("timed_calls", metricsOperation, metricsKernel, metrics.TimedCalls);
+                    exporter.ExportCounter("timed_input_bytes", metricsOperation, metricsKernel, metrics.TimedInputBytes);
+                    exporter.ExportCounter("cycles", metricsOperation, metricsKernel, metrics.Cycles);
+                    exporter.ExportHistogram("input_size", metricsOperation, metricsKernel, metrics.SizeHistogram, BASE64ENCODING_METRICS_SIZE_BUCKETS);
+                }
+            }
+        }
+
+        // Sets a function called after every recorded call, such as one emitting trace spans, or NULL to stop calling it
+        static void SetTraceHook(Base64TraceHook traceHook)
+        {
+            GetTraceHook().store(traceHook, std::memory_order_release);
+        }
+};
+
+#endif // Base64EncodingMetrics_h
@@ -0,0 +1,279 @@
+#ifndef Base64EncodingParallel_h
+#define Base64EncodingParallel_h
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Base64Encoding.hpp"
+
+// Inputs smaller than this are not worth splitting across threads
+#define BASE64ENCODING_PARALLEL_MINIMUM_CHUNK_LENGTH (256 * 1024)
+
+// Fixed set of worker threads that run the chunks of parallel encodes and decodes
+class Base64ThreadPool
+{
+    private:
+
+        std::vector<std::thread> Workers;
+
+        std::mutex Mutex;
+        std::mutex RunMutex;
+        std::condition_variable TaskAvailable;
+        std::condition_variable TasksCompleted;
+
+        // The task currently being run, invoked once for every index below TaskCount
+        const std::function<void(size_t)>* pTask;
+        size_t TaskCount;
+        size_t NextTask;
+        size_t CompletedTaskCount;
+        bool Stopping;
+
+        // Runs the next unclaimed task index, the mutex must be held on entry and is held again on return
+        void RunNextTask(std::unique_lock<std::mutex>& lock)
+        {
+            const std::function<void(size_t)>& task = *pTask;
+            size_t taskIndex = NextTask++;
+
+            lock.unlock();
+            task(taskIndex);
+            lock.lock();
+
+            if(++CompletedTaskCount == TaskCount)
+            {
+                TasksCompleted.notify_all();
+            }
+        }
+
+        void Work()
+        {
+            std::unique_lock<std::mutex> lock(Mutex);
+
+            while(true)
+            {
+                TaskAvailable.wait(lock, [this] { return Stopping || (pTask != NULL && NextTask < TaskCount); });
+
+                if(Stopping)
+                {
+                    return;
+                }
+
+                RunNextTask(lock);
+            }
+        }
+
+    public:
+
+        // Starts one worker fewer than the number of hardware threads, since the thread calling Run also takes part
+        Base64ThreadPool()
+          : Base64ThreadPool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0)
+        {
+
+        }
+
+        // Starts the given number of workers, the thread calling Run also takes part so zero workers runs every task on the caller
+        Base64ThreadPool(size_t workerCount)
+          : pTask(NULL),
+            TaskCount(0),
+            NextTask(0),
+            CompletedTaskCount(0),
+            Stopping(false)
+        {
+            for(size_t i = 0; i < workerCount; i++)
+            {
+                Workers.emplace_back(&Base64ThreadPool::Work, this);
+            }
+        }
+
+        ~Base64ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                Stopping = true;
+            }
+
+            TaskAvailable.notify_all();
+
+            for(std::thread& worker : Workers)
+            {
+                worker.join();
+            }
+        }
+
+        Base64ThreadPool(const Base64ThreadPool&) = delete;
+        Base64ThreadPool& operator=(const Base64ThreadPool&) = delete;
+
+        // Returns the number of threads that run tasks, including the caller of Run
+        size_t ThreadCount()
+        {
+            return Workers.size() + 1;
+        }
+
+        // Invokes the task with every index in [0, taskCount) across the workers and the calling thread
+        // Returns once every invocation has completed
+        void Run(size_t taskCount, const std::function<void(size_t)>& task)
+        {
+            std::lock_guard<std::mutex> runLock(RunMutex);
+            std::unique_lock<std::mutex> lock(Mutex);
+
+            pTask = &task;
+            TaskCount = taskCount;
+            NextTask = 0;
+            CompletedTaskCount = 0;
+
+            TaskAvailable.notify_all();
+
+            while(NextTask < TaskCount)
+            {
+                RunNextTask(lock);
+            }
+
+            TasksCompleted.wait(lock, [this] { return CompletedTaskCount == TaskCount; });
+
+            pTask = NULL;
+        }
+};
+
+// Splits large encodes and decodes into chunks processed concurrently by a thread pool
+// Chunks are split on whole groups, so each one is written straight to its final position in the output buffer
+class Base64ParallelEncoding
+{
+    private:
+
+        Base64Encoding& Encoding;
+
+        std::unique_ptr<Base64ThreadPool> pInternalThreadPool;
+        Base64ThreadPool& ThreadPool;
+
+        size_t MinimumChunkLength;
+
+        // Returns the number of chunks to split an input of the given length into, where each chunk covers the given number of groups
+        size_t ChunkCount(size_t groupCount, size_t groupLength)
+        {
+            size_t chunkCount = ThreadPool.ThreadCount();
+            size_t maximumChunkCount = (groupCount * groupLength) / MinimumChunkLength;
+
+            if(chunkCount > maximumChunkCount)
+            {
+                chunkCount = maximumChunkCount;
+            }
+
+            return chunkCount > 1 ? chunkCount : 1;
+        }
+
+    public:
+
+        // Uses a thread pool owned by this object, with a thread for every hardware thread
+        Base64ParallelEncoding(Base64Encoding& encoding)
+          : Encoding(encoding),
+            pInternalThreadPool(new Base64ThreadPool()),
+            ThreadPool(*pInternalThreadPool),
+            MinimumChunkLength(BASE64ENCODING_PARALLEL_MINIMUM_CHUNK_LENGTH)
+        {
+
+        }
+
+        // Uses a thread pool provided by the caller, which must outlive this object
+        Base64ParallelEncoding(Base64Encoding& encoding, Base64ThreadPool& threadPool)
+          : Encoding(encoding),
+            ThreadPool(threadPool),
+            MinimumChunkLength(BASE64ENCODING_PARALLEL_MINIMUM_CHUNK_LENGTH)
+        {
+
+        }
+
+        // Sets the smallest input length handed to a single thread
+        void SetMinimumChunkLength(size_t minimumChunkLength)
+        {
+            MinimumChunkLength = minimumChunkLength > 0 ? minimumChunkLength : 1;
+        }
+
+        // Converts binary data into a Base64 string, in the same way as Base64Encoding::Encode
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the encoded string
+        int64_t Encode(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            // Chunks are encoded without checking each result, so an encoding that rejects every call is caught first
+            if(!Encoding.IsValid())
+            {
+                return BASE64ENCODING_INVALID_ALPHABET;
+            }
+
+            size_t encodedLength = Encoding.EncodedLength(inputLength);
+
+            // Verify the output buffer is large enough to hold the encoded string
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW || outputBufferLength < encodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            size_t groupCount = inputLength / 3;
+            size_t chunkCount = ChunkCount(groupCount, 3);
+            size_t chunkGroupCount = groupCount / chunkCount;
+
+            // Every chunk but the last holds whole sets of three bytes, so none of them is padded
+            // Chunk i therefore starts at input offset i * chunkGroupCount * 3 and output offset i * chunkGroupCount * 4
+            ThreadPool.Run(chunkCount, [&](size_t chunk)
+            {
+                size_t inputOffset = chunk * chunkGroupCount * 3;
+                size_t outputOffset = chunk * chunkGroupCount * 4;
+                size_t chunkLength = (chunk == chunkCount - 1) ? (inputLength - inputOffset) : (chunkGroupCount * 3);
+
+                Encoding.Encode(pInputBuffer + inputOffset, chunkLength, pOutputBuffer + outputOffset, encodedLength - outputOffset);
+            });
+
+            return (int64_t)encodedLength;
+        }
+
+        // Converts a Base64 string into binary data, in the same way as Base64Encoding::Decode
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet
+        int64_t Decode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            size_t decodedLength = Encoding.DecodedLength(pInputBuffer, inputLength);
+
+            // Verify the output buffer is large enough to hold the decoded data
+            if(outputBufferLength < decodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            size_t groupCount = inputLength / 4;
+            size_t chunkCount = ChunkCount(groupCount, 4);
+            size_t chunkGroupCount = groupCount / chunkCount;
+
+            std::vector<int64_t> chunkResults(chunkCount);
+
+            // Every chunk but the last holds whole sets of four characters
+            // Chunk i therefore starts at input offset i * chunkGroupCount * 4 and output offset i * chunkGroupCount * 3
+            ThreadPool.Run(chunkCount, [&](size_t chunk)
+            {
+                size_t inputOffset = chunk * chunkGroupCount * 4;
+                size_t outputOffset = chunk * chunkGroupCount * 3;
+                size_t chunkLength = (chunk == chunkCount - 1) ? (inputLength - inputOffset) : (chunkGroupCount * 4);
+
+                // Padding is only valid at the end of the final chunk
+                if(chunk != chunkCount - 1 && pInputBuffer[inputOffset + chunkLength - 1] == '=')
+                {
+                    chunkResults[chunk] = BASE64ENCODING_INVALID_CHARACTER;
+                    return;
+                }
+
+                chunkResults[chunk] = Encoding.Decode(pInputBuffer + inputOffset, chunkLength, pOutputBuffer + outputOffset, decodedLength - outputOffset);
+            });
+
+            for(int64_t chunkResult : chunkResults)
+            {
+                if(chunkResult < 0)
+                {
+                    return chunkResult;
+                }
+            }
+
+            return (int64_t)decodedLength;
+        }
+};
+
+#endif // Base64EncodingParallel_h
@@ -0,0 +1,326 @@
+#ifndef Base64EncodingPipeline_h
+#define Base64EncodingPipeline_h
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+#include "Base64EncodingStream.hpp"
+
+// Returned when the reader or writer of a pipeline reports a failure
+#define BASE64ENCODING_PIPELINE_ERROR -4
+
+// Number of bytes or characters read at a time by a pipeline, a multiple of both three and four
+#define BASE64ENCODING_PIPELINE_CHUNK_LENGTH (192 * 1024)
+
+// Number of chunks in flight, one being read, one encoded or decoded and one written
+#define BASE64ENCODING_PIPELINE_BUFFER_COUNT 3
+
+// Encodes and decodes streams read and written through callbacks, such as files, pipes and sockets, overlapping the input and output with the conversion
+// A reader thread fills a ring of chunk buffers, the calling thread converts each chunk in turn and a writer thread empties them,
+// so chunk N + 1 is read and chunk N - 1 written while chunk N is converted
+// The reader is called as int64_t(void* pBuffer, size_t length) and returns the number of bytes read, zero at the end of the input or a negative value on failure
+// The writer is called as bool(const void* pData, size_t length) and returns whether all the data was written
+// Groups split between chunks are carried over by a Base64StreamEncoder or Base64StreamDecoder, so reads may return any number of bytes
+class Base64PipelineEncoding
+{
+    private:
+
+        typedef enum
+        {
+            Free,
+            Filled,
+            Converted
+        } ChunkState;
+
+        struct Chunk
+        {
+            std::vector<uint8_t> Input;
+            size_t InputLength;
+            bool ReadFailed;
+
+            std::vector<uint8_t> Output;
+            size_t OutputLength;
+
+            ChunkState State;
+        };
+
+        Base64Encoding& Encoding;
+
+        size_t ChunkLength;
+        size_t BufferCount;
+
+        // Runs the reader and writer on their own threads and converts every chunk on the calling thread
+        // The conversion is called as int64_t(const uint8_t* pInput, size_t inputLength, uint8_t* pOutput, size_t outputLength) for every chunk read,
+        // and with no input once the reader reaches the end of the input, to write anything carried over
+        template<typename TReader, typename TWriter, typename TConvert>
+        int64_t Run(TReader& reader, TWriter& writer, size_t outputLength, TConvert convert)
+        {
+            std::vector<Chunk> chunks(BufferCount);
+
+            for(Chunk& chunk : chunks)
+            {
+                chunk.Input.resize(ChunkLength);
+                chunk.Output.resize(outputLength);
+                chunk.State = ChunkState::Free;
+            }
+
+            std::mutex mutex;
+            std::condition_variable changed;
+
+            // Set by whichever stage fails first, after which no stage takes another chunk
+            bool stopping = false;
+            int64_t result = 0;
+            size_t writtenLength = 0;
+
+            std::thread readerThread([&]
+            {
+                for(size_t sequence = 0;; sequence++)
+                {
+                    Chunk& chunk = chunks[sequence % BufferCount];
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        changed.wait(lock, [&] { return stopping || chunk.State == ChunkState::Free; });
+
+                        if(stopping)
+                        {
+                            return;
+                        }
+                    }
+
+                    int64_t readLength = reader((void*)chunk.Input.data(), ChunkLength);
+
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    chunk.InputLength = readLength > 0 ? (size_t)readLength : 0;
+                    chunk.ReadFailed = readLength < 0;
+                    chunk.State = ChunkState::Filled;
+                    changed.notify_all();
+
+                    // An empty chunk marks the end of the input
+                    if(readLength <= 0)
+                    {
+                        return;
+                    }
+                }
+            });
+
+            std::thread writerThread([&]
+            {
+                for(size_t sequence = 0;; sequence++)
+                {
+                    Chunk& chunk = chunks[sequence % BufferCount];
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        changed.wait(lock, [&] { return stopping || chunk.State == ChunkState::Converted; });
+
+                        if(stopping)
+                        {
+                            return;
+                        }
+                    }
+
+                    bool finalChunk = chunk.InputLength == 0;
+
+                    if(chunk.OutputLength > 0 && !writer((const void*)chunk.Output.data(), chunk.OutputLength))
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+
+                        stopping = true;
+                        result = BASE64ENCODING_PIPELINE_ERROR;
+                        changed.notify_all();
+
+                        return;
+                    }
+
+                    std::lock_guard<std::mutex> lock(mutex);
+
+                    writtenLength += chunk.OutputLength;
+                    chunk.State = ChunkState::Free;
+                    changed.notify_all();
+
+                    if(finalChunk)
+                    {
+                        return;
+                    }
+                }
+            });
+
+            for(size_t sequence = 0;; sequence++)
+            {
+                Chunk& chunk = chunks[sequence % BufferCount];
+
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return stopping || chunk.State == ChunkState::Filled; });
+
+                    if(stopping)
+                    {
+                        break;
+                    }
+                }
+
+                int64_t convertedLength = chunk.ReadFailed ? BASE64ENCODING_PIPELINE_ERROR : convert(chunk.Input.data(), chunk.InputLength, chunk.Output.data(), outputLength);
+
+                std::lock_guard<std::mutex> lock(mutex);
+
+                if(convertedLength < 0)
+                {
+                    stopping = true;
+                    result = convertedLength;
+                    changed.notify_all();
+
+                    break;
+                }
+
+                chunk.OutputLength = (size_t)convertedLength;
+                chunk.State = ChunkState::Converted;
+                changed.notify_all();
+
+                if(chunk.InputLength == 0)
+                {
+                    break;
+                }
+            }
+
+            // A reader or writer call in progress when a stage fails is waited for
+            writerThread.join();
+            readerThread.join();
+
+            return result < 0 ? result : (int64_t)writtenLength;
+        }
+
+    public:
+
+        Base64PipelineEncoding(Base64Encoding& encoding)
+          : Base64PipelineEncoding(encoding, BASE64ENCODING_PIPELINE_CHUNK_LENGTH, BASE64ENCODING_PIPELINE_BUFFER_COUNT)
+        {
+
+        }
+
+        // Reads up to the given number of bytes or characters at a time into each of the given number of buffers, at least three for every stage to overlap
+        Base64PipelineEncoding(Base64Encoding& encoding, size_t chunkLength, size_t bufferCount)
+          : Encoding(encoding),
+            ChunkLength(chunkLength > 0 ? chunkLength : 1),
+            BufferCount(bufferCount > 0 ? bufferCount : 1)
+        {
+
+        }
+
+        // Converts the binary data read into a Base64 string written a chunk at a time, which is not null terminated
+        // Returns the length of the encoded string or BASE64ENCODING_PIPELINE_ERROR if the reader or writer fails
+        template<typename TReader, typename TWriter>
+        int64_t Encode(TReader&& reader, TWriter&& writer)
+        {
+            Base64StreamEncoder encoder(Encoding);
+
+            // Room for the bytes carried over from the previous chunk, and for Finish
+            size_t outputLength = Encoding.EncodedLength(ChunkLength + 2);
+
+            return Run(reader, writer, outputLength, [&](const uint8_t* pInput, size_t inputLength, uint8_t* pOutput, size_t outputBufferLength)
+            {
+                return inputLength > 0 ? encoder.Update(pInput, inputLength, (char*)pOutput, outputBufferLength) : encoder.Finish((char*)pOutput, outputBufferLength);
+            });
+        }
+
+        // Converts the Base64 string read into binary data written a chunk at a time
+        // Returns the length of the decoded data, BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet or data after padding
+        // or BASE64ENCODING_PIPELINE_ERROR if the reader or writer fails, in which case the data written so far should be discarded
+        template<typename TReader, typename TWriter>
+        int64_t Decode(TReader&& reader, TWriter&& writer)
+        {
+            Base64StreamDecoder decoder(Encoding);
+
+            // Room for the characters carried over from the previous chunk, and for Finish
+            size_t outputLength = ((ChunkLength + 3) / 4) * 3 + 3;
+
+            return Run(reader, writer, outputLength, [&](const uint8_t* pInput, size_t inputLength, uint8_t* pOutput, size_t outputBufferLength)
+            {
+                return inputLength > 0 ? decoder.Update((const char*)pInput, inputLength, pOutput, outputBufferLength) : decoder.Finish(pOutput, outputBufferLength);
+            });
+        }
+};
+
+#if !defined(_WIN32)
+
+// Reads a pipeline's input from a file descriptor, such as a file, pipe or socket, retrying reads interrupted by a signal
+class Base64DescriptorReader
+{
+    private:
+
+        int Descriptor;
+
+    public:
+
+        Base64DescriptorReader(int descriptor)
+          : Descriptor(descriptor)
+        {
+
+        }
+
+        int64_t operator()(void* pBuffer, size_t length)
+        {
+            ssize_t readLength;
+
+            do
+            {
+                readLength = read(Descriptor, pBuffer, length);
+            }
+            while(readLength < 0 && errno == EINTR);
+
+            return (int64_t)readLength;
+        }
+};
+
+// Writes a pipeline's output to a file descriptor, continuing after partial writes and writes interrupted by a signal
+class Base64DescriptorWriter
+{
+    private:
+
+        int Descriptor;
+
+    public:
+
+        Base64DescriptorWriter(int descriptor)
+          : Descriptor(descriptor)
+        {
+
+        }
+
+        bool operator()(const void* pData, size_t length)
+        {
+            const uint8_t* pBytes = (const uint8_t*)pData;
+
+            while(length > 0)
+            {
+                ssize_t writtenLength = write(Descriptor, pBytes, length);
+
+                if(writtenLength < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if(writtenLength <= 0)
+                {
+                    return false;
+                }
+
+                pBytes += writtenLength;
+                length -= (size_t)writtenLength;
+            }
+
+            return true;
+        }
+};
+
+#endif
+
+#endif // Base64EncodingPipeline_h
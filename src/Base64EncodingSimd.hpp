@@ -0,0 +1,1173 @@
+#ifndef Base64EncodingSimd_h
+#define Base64EncodingSimd_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Vectorized kernels are available on x86 targets unless explicitly disabled
+#if !defined(BASE64ENCODING_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define BASE64ENCODING_X86
+#endif
+
+#ifdef BASE64ENCODING_X86
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// GCC and Clang require functions using intrinsics above the baseline instruction set to be marked with their target
+#ifdef _MSC_VER
+#define BASE64ENCODING_TARGET(instructionSets)
+#else
+#define BASE64ENCODING_TARGET(instructionSets) __attribute__((target(instructionSets)))
+#endif
+
+#endif // BASE64ENCODING_X86
+
+// Number of bytes in each of the three lanes of CRC-32C computed side by side
+#define BASE64ENCODING_CRC32C_LANE_LENGTH 1024
+
+// Instruction set levels, ordered from least to most capable
+typedef enum
+{
+    Base64KernelScalar = 0,
+    Base64KernelSsse3 = 1,
+    Base64KernelAvx2 = 2,
+    Base64KernelAvx512Vbmi = 3
+} Base64EncodingKernel;
+
+class Base64EncodingSimd
+{
+    private:
+
+#ifdef BASE64ENCODING_X86
+
+        static void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4])
+        {
+#ifdef _MSC_VER
+            int values[4];
+            __cpuidex(values, (int)leaf, (int)subleaf);
+
+            for(int i = 0; i < 4; i++)
+            {
+                registers[i] = (uint32_t)values[i];
+            }
+#else
+            __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+        }
+
+        // Reads the register state the operating system saves on context switches
+        static uint64_t ExtendedControlRegister()
+        {
+#ifdef _MSC_VER
+            return _xgetbv(0);
+#else
+            uint32_t eax;
+            uint32_t edx;
+            __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return ((uint64_t)edx << 32) | eax;
+#endif
+        }
+
+        // Returns the index of the lowest set bit of a non-zero mask
+        static uint32_t CountTrailingZeros(uint32_t mask)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, mask);
+            return (uint32_t)index;
+#else
+            return (uint32_t)__builtin_ctz(mask);
+#endif
+        }
+
+        static Base64EncodingKernel DetectKernel()
+        {
+            uint32_t registers[4];
+
+            Cpuid(0, 0, registers);
+            uint32_t maximumLeaf = registers[0];
+
+            Cpuid(1, 0, registers);
+            bool ssse3 = registers[2] & (1 << 9);
+            bool osxsave = registers[2] & (1 << 27);
+            bool avx = registers[2] & (1 << 28);
+
+            if(!ssse3)
+            {
+                return Base64EncodingKernel::Base64KernelScalar;
+            }
+
+            if(!osxsave || !avx || maximumLeaf < 7)
+            {
+                return Base64EncodingKernel::Base64KernelSsse3;
+            }
+
+            uint64_t xcr0 = ExtendedControlRegister();
+
+            Cpuid(7, 0, registers);
+            bool avx2 = registers[1] & (1 << 5);
+            bool avx512f = registers[1] & (1 << 16);
+            bool avx512bw = registers[1] & (1u << 30);
+            bool avx512vbmi = registers[2] & (1 << 1);
+
+            // The operating system must preserve the XMM/YMM registers, and additionally the opmask and ZMM registers for AVX-512
+            bool ymmEnabled = (xcr0 & 0x06) == 0x06;
+            bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+
+            if(zmmEnabled && avx512f && avx512bw && avx512vbmi)
+            {
+                return Base64EncodingKernel::Base64KernelAvx512Vbmi;
+            }
+
+            if(ymmEnabled && avx2)
+            {
+                return Base64EncodingKernel::Base64KernelAvx2;
+            }
+
+            return Base64EncodingKernel::Base64KernelSsse3;
+        }
+
+        static bool DetectCrc32()
+        {
+            uint32_t registers[4];
+
+            Cpuid(1, 0, registers);
+            bool pclmulqdq = registers[2] & (1 << 1);
+            bool sse42 = registers[2] & (1 << 20);
+
+            return pclmulqdq && sse42;
+        }
+
+        // Returns x^bitCount modulo the CRC-32C polynomial, bit-reflected as the CRC register is
+        static constexpr uint32_t Crc32cPowerOfX(size_t bitCount)
+        {
+            uint32_t power = 1u << 31;
+
+            for(size_t i = 0; i < bitCount; i++)
+            {
+                power = (power & 1) ? (power >> 1) ^ 0x82F63B78 : power >> 1;
+            }
+
+            return power;
+        }
+
+        // Advances a CRC-32C register past as many zero bytes as the shift constant was built for, by a carry-less multiplication reduced with the CRC32 instruction
+        BASE64ENCODING_TARGET("sse4.2,pclmul")
+        static uint32_t ShiftCrc32c(uint32_t crc, uint32_t shift)
+        {
+            __m128i product = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)crc), _mm_cvtsi32_si128((int)shift), 0);
+
+            return (uint32_t)_mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(product));
+        }
+
+        // Rearranges each group of three bytes into four bytes holding one sextet each
+        BASE64ENCODING_TARGET("ssse3")
+        static __m128i UnpackSextetsSsse3(__m128i input)
+        {
+            input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+            __m128i sextets1And3 = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+            __m128i sextets2And4 = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+
+            return _mm_or_si128(sextets1And3, sextets2And4);
+        }
+
+        // Converts sextets to characters by adding the offset of the alphabet range each sextet falls into
+        BASE64ENCODING_TARGET("ssse3")
+        static __m128i TranslateSextetsSsse3(__m128i sextets, __m128i shiftTable)
+        {
+            __m128i index = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+            __m128i uppercase = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+            index = _mm_or_si128(index, _mm_and_si128(uppercase, _mm_set1_epi8(13)));
+
+            return _mm_add_epi8(sextets, _mm_shuffle_epi8(shiftTable, index));
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static __m256i UnpackSextetsAvx2(__m256i input)
+        {
+            input = _mm256_shuffle_epi8(input, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                                                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+
+            __m256i sextets1And3 = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+            __m256i sextets2And4 = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+
+            return _mm256_or_si256(sextets1And3, sextets2And4);
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static __m256i TranslateSextetsAvx2(__m256i sextets, __m256i shiftTable)
+        {
+            __m256i index = _mm256_subs_epu8(sextets, _mm256_set1_epi8(51));
+            __m256i uppercase = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), sextets);
+            index = _mm256_or_si256(index, _mm256_and_si256(uppercase, _mm256_set1_epi8(13)));
+
+            return _mm256_add_epi8(sextets, _mm256_shuffle_epi8(shiftTable, index));
+        }
+
+        // Returns a mask of the characters within [first, first + count)
+        // Biasing both sides by 128 turns the unsigned range check into a single signed comparison
+        BASE64ENCODING_TARGET("ssse3")
+        static __m128i CharactersInRangeSsse3(__m128i characters, char first, char count)
+        {
+            __m128i offset = _mm_sub_epi8(characters, _mm_set1_epi8((char)(first + 128)));
+            return _mm_cmpgt_epi8(_mm_set1_epi8((char)(count - 128)), offset);
+        }
+
+        // Converts characters to sextets, clearing the matching byte of the valid mask for any character outside the alphabet
+        // Letters and digits take precedence over the 62nd character, which takes precedence over the 63rd, as in the scalar table
+        BASE64ENCODING_TARGET("ssse3")
+        static __m128i TranslateCharactersSsse3(__m128i characters, __m128i character62, __m128i character63, __m128i shift62, __m128i shift63, __m128i& valid)
+        {
+            __m128i uppercase = CharactersInRangeSsse3(characters, 'A', 26);
+            __m128i lowercase = CharactersInRangeSsse3(characters, 'a', 26);
+            __m128i digit = CharactersInRangeSsse3(characters, '0', 10);
+            __m128i alphanumeric = _mm_or_si128(_mm_or_si128(uppercase, lowercase), digit);
+            __m128i is62 = _mm_andnot_si128(alphanumeric, _mm_cmpeq_epi8(characters, character62));
+            __m128i is63 = _mm_andnot_si128(_mm_or_si128(alphanumeric, is62), _mm_cmpeq_epi8(characters, character63));
+
+            __m128i shift = _mm_or_si128(_mm_and_si128(uppercase, _mm_set1_epi8(-65)), _mm_and_si128(lowercase, _mm_set1_epi8(-71)));
+            shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(4)));
+            shift = _mm_or_si128(shift, _mm_or_si128(_mm_and_si128(is62, shift62), _mm_and_si128(is63, shift63)));
+
+            valid = _mm_or_si128(_mm_or_si128(alphanumeric, is62), is63);
+
+            return _mm_add_epi8(characters, shift);
+        }
+
+        // Packs each group of four sextets into three bytes, placed in the low twelve bytes of the result
+        BASE64ENCODING_TARGET("ssse3")
+        static __m128i PackSextetsSsse3(__m128i sextets)
+        {
+            __m128i pairs = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+            __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+            return _mm_shuffle_epi8(groups, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static __m256i CharactersInRangeAvx2(__m256i characters, char first, char count)
+        {
+            __m256i offset = _mm256_sub_epi8(characters, _mm256_set1_epi8((char)(first + 128)));
+            return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(count - 128)), offset);
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static __m256i TranslateCharactersAvx2(__m256i characters, __m256i character62, __m256i character63, __m256i shift62, __m256i shift63, __m256i& valid)
+        {
+            __m256i uppercase = CharactersInRangeAvx2(characters, 'A', 26);
+            __m256i lowercase = CharactersInRangeAvx2(characters, 'a', 26);
+            __m256i digit = CharactersInRangeAvx2(characters, '0', 10);
+            __m256i alphanumeric = _mm256_or_si256(_mm256_or_si256(uppercase, lowercase), digit);
+            __m256i is62 = _mm256_andnot_si256(alphanumeric, _mm256_cmpeq_epi8(characters, character62));
+            __m256i is63 = _mm256_andnot_si256(_mm256_or_si256(alphanumeric, is62), _mm256_cmpeq_epi8(characters, character63));
+
+            __m256i shift = _mm256_or_si256(_mm256_and_si256(uppercase, _mm256_set1_epi8(-65)), _mm256_and_si256(lowercase, _mm256_set1_epi8(-71)));
+            shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(4)));
+            shift = _mm256_or_si256(shift, _mm256_or_si256(_mm256_and_si256(is62, shift62), _mm256_and_si256(is63, shift63)));
+
+            valid = _mm256_or_si256(_mm256_or_si256(alphanumeric, is62), is63);
+
+            return _mm256_add_epi8(characters, shift);
+        }
+
+        // Packs each group of four sextets into three bytes, placed in the low twenty-four bytes of the result
+        BASE64ENCODING_TARGET("avx2")
+        static __m256i PackSextetsAvx2(__m256i sextets)
+        {
+            __m256i pairs = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+            __m256i groups = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+
+            groups = _mm256_shuffle_epi8(groups, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                                  2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+            return _mm256_permutevar8x32_epi32(groups, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        }
+
+        // Looks up each byte in a table held as rows of sixteen entries, the row chosen by the high bits of the byte and the entry by its low four bits
+        // Every row is looked up for every byte, and the saturating add sets the top bit, which makes the shuffle give zero, wherever the byte lies outside the row
+        // Bytes before the first row or past the last row give zero
+        template<int RowCount, int FirstRow = 0>
+        BASE64ENCODING_TARGET("ssse3")
+        static __m128i LookupRowsSsse3(__m128i indices, const __m128i* pRows)
+        {
+            __m128i result = _mm_setzero_si128();
+
+            for(int row = FirstRow; row < RowCount; row++)
+            {
+                __m128i index = _mm_adds_epu8(_mm_xor_si128(indices, _mm_set1_epi8((char)(row << 4))), _mm_set1_epi8(0x70));
+                result = _mm_or_si128(result, _mm_shuffle_epi8(pRows[row], index));
+            }
+
+            return result;
+        }
+
+        template<int RowCount, int FirstRow = 0>
+        BASE64ENCODING_TARGET("avx2")
+        static __m256i LookupRowsAvx2(__m256i indices, const __m256i* pRows)
+        {
+            __m256i result = _mm256_setzero_si256();
+
+            for(int row = FirstRow; row < RowCount; row++)
+            {
+                __m256i index = _mm256_adds_epu8(_mm256_xor_si256(indices, _mm256_set1_epi8((char)(row << 4))), _mm256_set1_epi8(0x70));
+                result = _mm256_or_si256(result, _mm256_shuffle_epi8(pRows[row], index));
+            }
+
+            return result;
+        }
+
+#endif // BASE64ENCODING_X86
+
+    public:
+
+        // Returns the most capable kernel supported by the processor and operating system
+        static Base64EncodingKernel SupportedKernel()
+        {
+#ifdef BASE64ENCODING_X86
+            static const Base64EncodingKernel supportedKernel = DetectKernel();
+            return supportedKernel;
+#else
+            return Base64EncodingKernel::Base64KernelScalar;
+#endif
+        }
+
+        // Returns whether the processor has the SSE4.2 CRC32 instruction, which computes CRC-32C, and the PCLMULQDQ instruction to combine interleaved CRCs
+        static bool SupportsCrc32()
+        {
+#ifdef BASE64ENCODING_X86
+            static const bool supportsCrc32 = DetectCrc32();
+            return supportsCrc32;
+#else
+            return false;
+#endif
+        }
+
+        // Builds the 16-entry table of offsets used to translate sextets to characters
+        // Entry 0 covers lowercase letters, 1-10 digits, 11 and 12 the 62nd and 63rd characters and 13 uppercase letters
+        static constexpr void BuildEncodeShiftTable(const char character62, const char character63, int8_t shiftTable[16])
+        {
+            shiftTable[0] = 'a' - 26;
+
+            for(int i = 1; i <= 10; i++)
+            {
+                shiftTable[i] = '0' - 52;
+            }
+
+            shiftTable[11] = (int8_t)((uint8_t)character62 - 62);
+            shiftTable[12] = (int8_t)((uint8_t)character63 - 63);
+            shiftTable[13] = 'A';
+            shiftTable[14] = 0;
+            shiftTable[15] = 0;
+        }
+
+#ifdef BASE64ENCODING_X86
+
+        // Each encode kernel processes whole groups of three bytes and returns the number of input bytes consumed
+        // The caller encodes the remaining input with the scalar loop
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t EncodeSsse3(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, const int8_t* pShiftTable)
+        {
+            const __m128i shiftTable = _mm_loadu_si128((const __m128i*)pShiftTable);
+            size_t consumed = 0;
+
+            // Twelve bytes are encoded per iteration, but sixteen are loaded
+            while(inputLength - consumed >= 16)
+            {
+                __m128i input = _mm_loadu_si128((const __m128i*)(pInputBuffer + consumed));
+                __m128i output = TranslateSextetsSsse3(UnpackSextetsSsse3(input), shiftTable);
+
+                _mm_storeu_si128((__m128i*)pOutputBuffer, output);
+
+                consumed += 12;
+                pOutputBuffer += 16;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t EncodeAvx2(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, const int8_t* pShiftTable)
+        {
+            const __m256i shiftTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)pShiftTable));
+            size_t consumed = 0;
+
+            // Twenty-four bytes are encoded per iteration, loaded as two overlapping sixteen byte halves
+            while(inputLength - consumed >= 28)
+            {
+                const uint8_t* pInput = pInputBuffer + consumed;
+                __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pInput)), _mm_loadu_si128((const __m128i*)(pInput + 12)), 1);
+                __m256i output = TranslateSextetsAvx2(UnpackSextetsAvx2(input), shiftTable);
+
+                _mm256_storeu_si256((__m256i*)pOutputBuffer, output);
+
+                consumed += 24;
+                pOutputBuffer += 32;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx512f,avx512bw,avx512vbmi")
+        static size_t EncodeAvx512Vbmi(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, const char* pEncodeTable)
+        {
+            // Places the three bytes of each group into a 32-bit lane, in the same arrangement as the SSSE3 shuffle
+            const __m512i shuffle = _mm512_setr_epi32(0x01020001, 0x04050304, 0x07080607, 0x0A0B090A,
+                                                      0x0D0E0C0D, 0x10110F10, 0x13141213, 0x16171516,
+                                                      0x191A1819, 0x1C1D1B1C, 0x1F201E1F, 0x22232122,
+                                                      0x25262425, 0x28292728, 0x2B2C2A2B, 0x2E2F2D2E);
+
+            // Bit offsets of the four sextets within each pair of 32-bit lanes
+            const __m512i sextetOffsets = _mm512_set1_epi64(0x3036242A1016040A);
+
+            const __m512i encodeTable = _mm512_loadu_si512((const void*)pEncodeTable);
+            size_t consumed = 0;
+
+            // With every lane selected the zero-masking forms give the same result as the unmasked ones
+            // but avoid GCC reporting the undefined source operand of the unmasked forms as uninitialized
+            const __mmask64 allLanes = ~(__mmask64)0;
+
+            // Forty-eight bytes are encoded per iteration, the masked load never reads past them
+            while(inputLength - consumed >= 48)
+            {
+                __m512i input = _mm512_maskz_loadu_epi8(0x0000FFFFFFFFFFFF, pInputBuffer + consumed);
+                __m512i sextets = _mm512_maskz_multishift_epi64_epi8(allLanes, sextetOffsets, _mm512_maskz_permutexvar_epi8(allLanes, shuffle, input));
+
+                // Only the low six bits of each index select a table entry
+                _mm512_storeu_si512((void*)pOutputBuffer, _mm512_maskz_permutexvar_epi8(allLanes, sextets, encodeTable));
+
+                consumed += 48;
+                pOutputBuffer += 64;
+            }
+
+            return consumed;
+        }
+
+        // Each table encode kernel behaves as the encode kernel of the same instruction set, for any alphabet rather than only those laid out as the standard one
+        // The sextets are translated by looking them up in the 64 characters of the alphabet, sixteen at a time
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t EncodeTableSsse3(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, const char* pEncodeTable)
+        {
+            const __m128i rows[4] = { _mm_loadu_si128((const __m128i*)pEncodeTable), _mm_loadu_si128((const __m128i*)(pEncodeTable + 16)),
+                                      _mm_loadu_si128((const __m128i*)(pEncodeTable + 32)), _mm_loadu_si128((const __m128i*)(pEncodeTable + 48)) };
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 16)
+            {
+                __m128i input = _mm_loadu_si128((const __m128i*)(pInputBuffer + consumed));
+
+                _mm_storeu_si128((__m128i*)pOutputBuffer, LookupRowsSsse3<4>(UnpackSextetsSsse3(input), rows));
+
+                consumed += 12;
+                pOutputBuffer += 16;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t EncodeTableAvx2(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, const char* pEncodeTable)
+        {
+            __m256i rows[4];
+
+            for(int row = 0; row < 4; row++)
+            {
+                rows[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(pEncodeTable + row * 16)));
+            }
+
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 28)
+            {
+                const uint8_t* pInput = pInputBuffer + consumed;
+                __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pInput)), _mm_loadu_si128((const __m128i*)(pInput + 12)), 1);
+
+                _mm256_storeu_si256((__m256i*)pOutputBuffer, LookupRowsAvx2<4>(UnpackSextetsAvx2(input), rows));
+
+                consumed += 24;
+                pOutputBuffer += 32;
+            }
+
+            return consumed;
+        }
+
+        // Each line encode kernel encodes whole lines of the given length, a multiple of four, and writes a LF or CRLF line break after each one
+        // Lines are encoded a block at a time, and the final partial block of a line may store characters past the line break,
+        // which the following line overwrites, so a kernel only encodes lines followed by further input and stays within the given output length
+        // Returns the number of input bytes consumed, and sets the number of characters written
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t EncodeLinesSsse3(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputLength, const int8_t* pShiftTable,
+                                       size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            const __m128i shiftTable = _mm_loadu_si128((const __m128i*)pShiftTable);
+            size_t lineInputLength = (lineLength / 4) * 3;
+            size_t consumed = 0;
+
+            writtenLength = 0;
+
+            // The final block of a line loads up to sixteen bytes past the line and stores up to sixteen characters past it
+            while(inputLength - consumed >= lineInputLength + 16 && outputLength - writtenLength >= lineLength + lineBreakLength + 16)
+            {
+                const uint8_t* pLine = pInputBuffer + consumed;
+                char* pOutput = pOutputBuffer + writtenLength;
+
+                for(size_t offset = 0; offset < lineLength; offset += 16)
+                {
+                    __m128i input = _mm_loadu_si128((const __m128i*)(pLine + (offset / 4) * 3));
+
+                    _mm_storeu_si128((__m128i*)(pOutput + offset), TranslateSextetsSsse3(UnpackSextetsSsse3(input), shiftTable));
+                }
+
+                if(lineBreakLength == 2)
+                {
+                    pOutput[lineLength] = '\r';
+                }
+
+                pOutput[lineLength + lineBreakLength - 1] = '\n';
+
+                consumed += lineInputLength;
+                writtenLength += lineLength + lineBreakLength;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t EncodeLinesAvx2(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputLength, const int8_t* pShiftTable,
+                                      size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            const __m256i shiftTable = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)pShiftTable));
+            size_t lineInputLength = (lineLength / 4) * 3;
+            size_t consumed = 0;
+
+            writtenLength = 0;
+
+            // The final block of a line loads up to twenty-eight bytes past the line and stores up to thirty-two characters past it
+            while(inputLength - consumed >= lineInputLength + 28 && outputLength - writtenLength >= lineLength + lineBreakLength + 32)
+            {
+                const uint8_t* pLine = pInputBuffer + consumed;
+                char* pOutput = pOutputBuffer + writtenLength;
+
+                for(size_t offset = 0; offset < lineLength; offset += 32)
+                {
+                    const uint8_t* pInput = pLine + (offset / 4) * 3;
+                    __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pInput)), _mm_loadu_si128((const __m128i*)(pInput + 12)), 1);
+
+                    _mm256_storeu_si256((__m256i*)(pOutput + offset), TranslateSextetsAvx2(UnpackSextetsAvx2(input), shiftTable));
+                }
+
+                if(lineBreakLength == 2)
+                {
+                    pOutput[lineLength] = '\r';
+                }
+
+                pOutput[lineLength + lineBreakLength - 1] = '\n';
+
+                consumed += lineInputLength;
+                writtenLength += lineLength + lineBreakLength;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx512f,avx512bw,avx512vbmi")
+        static size_t EncodeLinesAvx512Vbmi(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputLength, const char* pEncodeTable,
+                                            size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            // The same shuffle and sextet offsets as EncodeAvx512Vbmi
+            const __m512i shuffle = _mm512_setr_epi32(0x01020001, 0x04050304, 0x07080607, 0x0A0B090A,
+                                                      0x0D0E0C0D, 0x10110F10, 0x13141213, 0x16171516,
+                                                      0x191A1819, 0x1C1D1B1C, 0x1F201E1F, 0x22232122,
+                                                      0x25262425, 0x28292728, 0x2B2C2A2B, 0x2E2F2D2E);
+            const __m512i sextetOffsets = _mm512_set1_epi64(0x3036242A1016040A);
+            const __m512i encodeTable = _mm512_loadu_si512((const void*)pEncodeTable);
+            const __mmask64 allLanes = ~(__mmask64)0;
+
+            // The final block of a line is loaded and stored through masks, so nothing past the line is touched
+            size_t partialBlockLength = lineLength % 64;
+            const __mmask64 partialLoadMask = ((__mmask64)1 << ((partialBlockLength / 4) * 3)) - 1;
+            const __mmask64 partialStoreMask = ((__mmask64)1 << partialBlockLength) - 1;
+            size_t wholeBlockLength = lineLength - partialBlockLength;
+
+            size_t lineInputLength = (lineLength / 4) * 3;
+            size_t consumed = 0;
+
+            writtenLength = 0;
+
+            // Only lines followed by further input are encoded, since the final line has no line break
+            while(inputLength - consumed > lineInputLength && outputLength - writtenLength >= lineLength + lineBreakLength)
+            {
+                const uint8_t* pLine = pInputBuffer + consumed;
+                char* pOutput = pOutputBuffer + writtenLength;
+                size_t offset = 0;
+
+                for(; offset < wholeBlockLength; offset += 64)
+                {
+                    __m512i input = _mm512_maskz_loadu_epi8(0x0000FFFFFFFFFFFF, pLine + (offset / 4) * 3);
+                    __m512i sextets = _mm512_maskz_multishift_epi64_epi8(allLanes, sextetOffsets, _mm512_maskz_permutexvar_epi8(allLanes, shuffle, input));
+
+                    _mm512_storeu_si512((void*)(pOutput + offset), _mm512_maskz_permutexvar_epi8(allLanes, sextets, encodeTable));
+                }
+
+                if(partialBlockLength != 0)
+                {
+                    __m512i input = _mm512_maskz_loadu_epi8(partialLoadMask, pLine + (offset / 4) * 3);
+                    __m512i sextets = _mm512_maskz_multishift_epi64_epi8(allLanes, sextetOffsets, _mm512_maskz_permutexvar_epi8(allLanes, shuffle, input));
+
+                    _mm512_mask_storeu_epi8(pOutput + offset, partialStoreMask, _mm512_maskz_permutexvar_epi8(allLanes, sextets, encodeTable));
+                }
+
+                if(lineBreakLength == 2)
+                {
+                    pOutput[lineLength] = '\r';
+                }
+
+                pOutput[lineLength + lineBreakLength - 1] = '\n';
+
+                consumed += lineInputLength;
+                writtenLength += lineLength + lineBreakLength;
+            }
+
+            return consumed;
+        }
+
+        // Each decode kernel processes whole groups of four characters and returns the number of input characters consumed
+        // A kernel stops before the first block holding a character outside the alphabet, leaving the scalar loop to flag it
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t DecodeSsse3(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const char character62, const char character63)
+        {
+            const __m128i characters62 = _mm_set1_epi8(character62);
+            const __m128i characters63 = _mm_set1_epi8(character63);
+            const __m128i shift62 = _mm_set1_epi8((char)(62 - character62));
+            const __m128i shift63 = _mm_set1_epi8((char)(63 - character63));
+            size_t consumed = 0;
+
+            // Sixteen bytes are stored per iteration, so at least four further decoded bytes must follow
+            while(inputLength - consumed >= 24)
+            {
+                __m128i valid;
+                __m128i input = _mm_loadu_si128((const __m128i*)(pInputBuffer + consumed));
+                __m128i sextets = TranslateCharactersSsse3(input, characters62, characters63, shift62, shift63, valid);
+
+                if(_mm_movemask_epi8(valid) != 0xFFFF)
+                {
+                    break;
+                }
+
+                _mm_storeu_si128((__m128i*)pOutputBuffer, PackSextetsSsse3(sextets));
+
+                consumed += 16;
+                pOutputBuffer += 12;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t DecodeAvx2(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const char character62, const char character63)
+        {
+            const __m256i characters62 = _mm256_set1_epi8(character62);
+            const __m256i characters63 = _mm256_set1_epi8(character63);
+            const __m256i shift62 = _mm256_set1_epi8((char)(62 - character62));
+            const __m256i shift63 = _mm256_set1_epi8((char)(63 - character63));
+            size_t consumed = 0;
+
+            // Thirty-two bytes are stored per iteration, so at least eight further decoded bytes must follow
+            while(inputLength - consumed >= 44)
+            {
+                __m256i valid;
+                __m256i input = _mm256_loadu_si256((const __m256i*)(pInputBuffer + consumed));
+                __m256i sextets = TranslateCharactersAvx2(input, characters62, characters63, shift62, shift63, valid);
+
+                if(_mm256_movemask_epi8(valid) != -1)
+                {
+                    break;
+                }
+
+                _mm256_storeu_si256((__m256i*)pOutputBuffer, PackSextetsAvx2(sextets));
+
+                consumed += 32;
+                pOutputBuffer += 24;
+            }
+
+            return consumed;
+        }
+
+        // Each table decode kernel behaves as the decode kernel of the same instruction set, for any alphabet rather than only those laid out as the standard one
+        // The characters are translated by looking them up in the first 128 entries of the character to sextet table, whose entries for characters outside the alphabet have their top bit set
+        // Characters past the ASCII range also have their top bit set, so a kernel stops before them even when the alphabet holds them, leaving them to the scalar loop
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t DecodeTableSsse3(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const uint8_t* pDecodeTable)
+        {
+            __m128i rows[8];
+
+            for(int row = 0; row < 8; row++)
+            {
+                rows[row] = _mm_loadu_si128((const __m128i*)(pDecodeTable + row * 16));
+            }
+
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 24)
+            {
+                __m128i input = _mm_loadu_si128((const __m128i*)(pInputBuffer + consumed));
+                __m128i sextets = LookupRowsSsse3<8>(input, rows);
+
+                if(_mm_movemask_epi8(_mm_or_si128(sextets, input)) != 0)
+                {
+                    break;
+                }
+
+                _mm_storeu_si128((__m128i*)pOutputBuffer, PackSextetsSsse3(sextets));
+
+                consumed += 16;
+                pOutputBuffer += 12;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t DecodeTableAvx2(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const uint8_t* pDecodeTable)
+        {
+            __m256i rows[8];
+
+            for(int row = 0; row < 8; row++)
+            {
+                rows[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(pDecodeTable + row * 16)));
+            }
+
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 44)
+            {
+                __m256i input = _mm256_loadu_si256((const __m256i*)(pInputBuffer + consumed));
+                __m256i sextets = LookupRowsAvx2<8>(input, rows);
+
+                if(_mm256_movemask_epi8(_mm256_or_si256(sextets, input)) != 0)
+                {
+                    break;
+                }
+
+                _mm256_storeu_si256((__m256i*)pOutputBuffer, PackSextetsAvx2(sextets));
+
+                consumed += 32;
+                pOutputBuffer += 24;
+            }
+
+            return consumed;
+        }
+
+        // A single two-table permute looks up all 128 entries at once
+        BASE64ENCODING_TARGET("avx512f,avx512bw,avx512vbmi")
+        static size_t DecodeTableAvx512Vbmi(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const uint8_t* pDecodeTable)
+        {
+            // Gathers the three bytes of each group from the top of its 32-bit lane down into the low forty-eight bytes
+            const __m512i pack = _mm512_setr_epi32(0x06000102, 0x090A0405, 0x0C0D0E08, 0x16101112,
+                                                   0x191A1415, 0x1C1D1E18, 0x26202122, 0x292A2425,
+                                                   0x2C2D2E28, 0x36303132, 0x393A3435, 0x3C3D3E38,
+                                                   0, 0, 0, 0);
+
+            const __m512i decodeTableLow = _mm512_loadu_si512((const void*)pDecodeTable);
+            const __m512i decodeTableHigh = _mm512_loadu_si512((const void*)(pDecodeTable + 64));
+            const __mmask64 allLanes = ~(__mmask64)0;
+            size_t consumed = 0;
+
+            // Forty-eight bytes are stored per iteration through a mask, so nothing past them is touched
+            while(inputLength - consumed >= 64)
+            {
+                __m512i input = _mm512_loadu_si512((const void*)(pInputBuffer + consumed));
+                __m512i sextets = _mm512_maskz_permutex2var_epi8(allLanes, decodeTableLow, input, decodeTableHigh);
+
+                if(_mm512_movepi8_mask(_mm512_or_si512(sextets, input)) != 0)
+                {
+                    break;
+                }
+
+                __m512i pairs = _mm512_maddubs_epi16(sextets, _mm512_set1_epi32(0x01400140));
+                __m512i groups = _mm512_madd_epi16(pairs, _mm512_set1_epi32(0x00011000));
+
+                _mm512_mask_storeu_epi8(pOutputBuffer, 0x0000FFFFFFFFFFFF, _mm512_maskz_permutexvar_epi8(allLanes, pack, groups));
+
+                consumed += 64;
+                pOutputBuffer += 48;
+            }
+
+            return consumed;
+        }
+
+        // Each marked decode kernel behaves as the table decode kernel of the same instruction set, for a character to sextet table whose entries may also carry
+        // either of two marks above the sextet, 0x40 or 0x80, and carry both for characters outside the alphabet
+        // The entries are ORed together as they are decoded, and bit 0 of found is set if any carried the 0x40 mark and bit 1 if any carried the 0x80 mark
+        // Every character of the alphabet must be printable ASCII, so the SSSE3 and AVX2 kernels skip the first two rows of the table and reject any byte
+        // below a space, or past the ASCII range, by comparing it as a signed byte
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t DecodeMarkedSsse3(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const uint8_t* pDecodeTable, uint32_t& found)
+        {
+            __m128i rows[8];
+
+            for(int row = 0; row < 8; row++)
+            {
+                rows[row] = _mm_loadu_si128((const __m128i*)(pDecodeTable + row * 16));
+            }
+
+            const __m128i sextetMask = _mm_set1_epi8(0x3F);
+            const __m128i spaces = _mm_set1_epi8(' ');
+            __m128i marks = _mm_setzero_si128();
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 24)
+            {
+                __m128i input = _mm_loadu_si128((const __m128i*)(pInputBuffer + consumed));
+                __m128i entries = LookupRowsSsse3<8, 2>(input, rows);
+
+                // Adding an entry to itself moves the 0x40 mark up to the top bit, which survives the AND only where both marks are set
+                if(_mm_movemask_epi8(_mm_or_si128(_mm_and_si128(entries, _mm_add_epi8(entries, entries)), _mm_cmpgt_epi8(spaces, input))) != 0)
+                {
+                    break;
+                }
+
+                marks = _mm_or_si128(marks, entries);
+
+                _mm_storeu_si128((__m128i*)pOutputBuffer, PackSextetsSsse3(_mm_and_si128(entries, sextetMask)));
+
+                consumed += 16;
+                pOutputBuffer += 12;
+            }
+
+            found |= (_mm_movemask_epi8(_mm_add_epi8(marks, marks)) != 0 ? 1 : 0) | (_mm_movemask_epi8(marks) != 0 ? 2 : 0);
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t DecodeMarkedAvx2(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const uint8_t* pDecodeTable, uint32_t& found)
+        {
+            __m256i rows[8];
+
+            for(int row = 0; row < 8; row++)
+            {
+                rows[row] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(pDecodeTable + row * 16)));
+            }
+
+            const __m256i sextetMask = _mm256_set1_epi8(0x3F);
+            const __m256i spaces = _mm256_set1_epi8(' ');
+            __m256i marks = _mm256_setzero_si256();
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 44)
+            {
+                __m256i input = _mm256_loadu_si256((const __m256i*)(pInputBuffer + consumed));
+                __m256i entries = LookupRowsAvx2<8, 2>(input, rows);
+
+                if(_mm256_movemask_epi8(_mm256_or_si256(_mm256_and_si256(entries, _mm256_add_epi8(entries, entries)), _mm256_cmpgt_epi8(spaces, input))) != 0)
+                {
+                    break;
+                }
+
+                marks = _mm256_or_si256(marks, entries);
+
+                _mm256_storeu_si256((__m256i*)pOutputBuffer, PackSextetsAvx2(_mm256_and_si256(entries, sextetMask)));
+
+                consumed += 32;
+                pOutputBuffer += 24;
+            }
+
+            found |= (_mm256_movemask_epi8(_mm256_add_epi8(marks, marks)) != 0 ? 1 : 0) | (_mm256_movemask_epi8(marks) != 0 ? 2 : 0);
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx512f,avx512bw,avx512vbmi")
+        static size_t DecodeMarkedAvx512Vbmi(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, const uint8_t* pDecodeTable, uint32_t& found)
+        {
+            // Gathers the three bytes of each group from the top of its 32-bit lane down into the low forty-eight bytes
+            const __m512i pack = _mm512_setr_epi32(0x06000102, 0x090A0405, 0x0C0D0E08, 0x16101112,
+                                                   0x191A1415, 0x1C1D1E18, 0x26202122, 0x292A2425,
+                                                   0x2C2D2E28, 0x36303132, 0x393A3435, 0x3C3D3E38,
+                                                   0, 0, 0, 0);
+
+            const __m512i decodeTableLow = _mm512_loadu_si512((const void*)pDecodeTable);
+            const __m512i decodeTableHigh = _mm512_loadu_si512((const void*)(pDecodeTable + 64));
+            const __m512i sextetMask = _mm512_set1_epi8(0x3F);
+            const __mmask64 allLanes = ~(__mmask64)0;
+            __m512i marks = _mm512_setzero_si512();
+            size_t consumed = 0;
+
+            while(inputLength - consumed >= 64)
+            {
+                __m512i input = _mm512_loadu_si512((const void*)(pInputBuffer + consumed));
+                __m512i entries = _mm512_maskz_permutex2var_epi8(allLanes, decodeTableLow, input, decodeTableHigh);
+
+                if(_mm512_movepi8_mask(_mm512_or_si512(_mm512_and_si512(entries, _mm512_add_epi8(entries, entries)), input)) != 0)
+                {
+                    break;
+                }
+
+                marks = _mm512_or_si512(marks, entries);
+
+                __m512i pairs = _mm512_maddubs_epi16(_mm512_and_si512(entries, sextetMask), _mm512_set1_epi32(0x01400140));
+                __m512i groups = _mm512_madd_epi16(pairs, _mm512_set1_epi32(0x00011000));
+
+                _mm512_mask_storeu_epi8(pOutputBuffer, 0x0000FFFFFFFFFFFF, _mm512_maskz_permutexvar_epi8(allLanes, pack, groups));
+
+                consumed += 64;
+                pOutputBuffer += 48;
+            }
+
+            found |= (_mm512_movepi8_mask(_mm512_add_epi8(marks, marks)) != 0 ? 1 : 0) | (_mm512_movepi8_mask(marks) != 0 ? 2 : 0);
+
+            return consumed;
+        }
+
+        // Scans whole blocks of sixteen characters for the first of either of two characters
+        // Returns its offset, or the number of characters scanned if no whole block holds either
+        BASE64ENCODING_TARGET("sse2")
+        static size_t FindEitherCharacterSse2(const char* pInputBuffer, size_t inputLength, char first, char second)
+        {
+            const __m128i firsts = _mm_set1_epi8(first);
+            const __m128i seconds = _mm_set1_epi8(second);
+            size_t scanned = 0;
+
+            for(; inputLength - scanned >= 16; scanned += 16)
+            {
+                __m128i input = _mm_loadu_si128((const __m128i*)(pInputBuffer + scanned));
+                uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(input, firsts), _mm_cmpeq_epi8(input, seconds)));
+
+                if(mask != 0)
+                {
+                    return scanned + CountTrailingZeros(mask);
+                }
+            }
+
+            return scanned;
+        }
+
+        // Each line decode kernel processes whole lines of the given length, each followed by a LF or CRLF line break, straight from the input
+        // Lines are decoded a block at a time, with the characters past the end of the final partial block replaced by a valid character
+        // A kernel stops before the first line holding a character outside the alphabet or not followed by the line break
+        // Returns the number of input characters consumed, and sets the number of bytes written
+
+        BASE64ENCODING_TARGET("ssse3")
+        static size_t DecodeLinesSsse3(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength,
+                                       const char character62, const char character63, size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            const __m128i characters62 = _mm_set1_epi8(character62);
+            const __m128i characters63 = _mm_set1_epi8(character63);
+            const __m128i shift62 = _mm_set1_epi8((char)(62 - character62));
+            const __m128i shift63 = _mm_set1_epi8((char)(63 - character63));
+            const __m128i fill = _mm_set1_epi8('A');
+
+            size_t wholeBlockLength = lineLength - (lineLength % 16);
+            const __m128i partialBlockMask = _mm_cmpgt_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), _mm_set1_epi8((char)(lineLength % 16 - 1)));
+
+            size_t lineDecodedLength = (lineLength / 4) * 3;
+            size_t consumed = 0;
+
+            writtenLength = 0;
+
+            // The final partial block reads up to sixteen characters past the line and stores up to sixteen bytes past its decoded data
+            while(inputLength - consumed >= lineLength + lineBreakLength + 16 && outputBufferLength - writtenLength >= lineDecodedLength + 16)
+            {
+                const char* pLine = pInputBuffer + consumed;
+                uint8_t* pOutput = pOutputBuffer + writtenLength;
+                __m128i valid;
+                __m128i sextets;
+
+                if(pLine[lineLength + lineBreakLength - 1] != '\n' || (lineBreakLength == 2 && pLine[lineLength] != '\r'))
+                {
+                    break;
+                }
+
+                size_t offset = 0;
+
+                for(; offset < wholeBlockLength; offset += 16)
+                {
+                    sextets = TranslateCharactersSsse3(_mm_loadu_si128((const __m128i*)(pLine + offset)), characters62, characters63, shift62, shift63, valid);
+
+                    if(_mm_movemask_epi8(valid) != 0xFFFF)
+                    {
+                        break;
+                    }
+
+                    _mm_storeu_si128((__m128i*)(pOutput + (offset / 4) * 3), PackSextetsSsse3(sextets));
+                }
+
+                if(offset < wholeBlockLength)
+                {
+                    break;
+                }
+
+                if(offset < lineLength)
+                {
+                    __m128i characters = _mm_loadu_si128((const __m128i*)(pLine + offset));
+                    characters = _mm_or_si128(_mm_and_si128(partialBlockMask, fill), _mm_andnot_si128(partialBlockMask, characters));
+                    sextets = TranslateCharactersSsse3(characters, characters62, characters63, shift62, shift63, valid);
+
+                    if(_mm_movemask_epi8(valid) != 0xFFFF)
+                    {
+                        break;
+                    }
+
+                    _mm_storeu_si128((__m128i*)(pOutput + (offset / 4) * 3), PackSextetsSsse3(sextets));
+                }
+
+                consumed += lineLength + lineBreakLength;
+                writtenLength += lineDecodedLength;
+            }
+
+            return consumed;
+        }
+
+        BASE64ENCODING_TARGET("avx2")
+        static size_t DecodeLinesAvx2(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength,
+                                      const char character62, const char character63, size_t lineLength, size_t lineBreakLength, size_t& writtenLength)
+        {
+            const __m256i characters62 = _mm256_set1_epi8(character62);
+            const __m256i characters63 = _mm256_set1_epi8(character63);
+            const __m256i shift62 = _mm256_set1_epi8((char)(62 - character62));
+            const __m256i shift63 = _mm256_set1_epi8((char)(63 - character63));
+            const __m256i fill = _mm256_set1_epi8('A');
+
+            size_t wholeBlockLength = lineLength - (lineLength % 32);
+            const __m256i partialBlockMask = _mm256_cmpgt_epi8(_mm256_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                                                                16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31),
+                                                               _mm256_set1_epi8((char)(lineLength % 32 - 1)));
+
+            size_t lineDecodedLength = (lineLength / 4) * 3;
+            size_t consumed = 0;
+
+            writtenLength = 0;
+
+            // The final partial block reads up to thirty-two characters past the line and stores up to thirty-two bytes past its decoded data
+            while(inputLength - consumed >= lineLength + lineBreakLength + 32 && outputBufferLength - writtenLength >= lineDecodedLength + 32)
+            {
+                const char* pLine = pInputBuffer + consumed;
+                uint8_t* pOutput = pOutputBuffer + writtenLength;
+                __m256i valid;
+                __m256i sextets;
+
+                if(pLine[lineLength + lineBreakLength - 1] != '\n' || (lineBreakLength == 2 && pLine[lineLength] != '\r'))
+                {
+                    break;
+                }
+
+                size_t offset = 0;
+
+                for(; offset < wholeBlockLength; offset += 32)
+                {
+                    sextets = TranslateCharactersAvx2(_mm256_loadu_si256((const __m256i*)(pLine + offset)), characters62, characters63, shift62, shift63, valid);
+
+                    if(_mm256_movemask_epi8(valid) != -1)
+                    {
+                        break;
+                    }
+
+                    _mm256_storeu_si256((__m256i*)(pOutput + (offset / 4) * 3), PackSextetsAvx2(sextets));
+                }
+
+                if(offset < wholeBlockLength)
+                {
+                    break;
+                }
+
+                if(offset < lineLength)
+                {
+                    __m256i characters = _mm256_blendv_epi8(_mm256_loadu_si256((const __m256i*)(pLine + offset)), fill, partialBlockMask);
+                    sextets = TranslateCharactersAvx2(characters, characters62, characters63, shift62, shift63, valid);
+
+                    if(_mm256_movemask_epi8(valid) != -1)
+                    {
+                        break;
+                    }
+
+                    _mm256_storeu_si256((__m256i*)(pOutput + (offset / 4) * 3), PackSextetsAvx2(sextets));
+                }
+
+                consumed += lineLength + lineBreakLength;
+                writtenLength += lineDecodedLength;
+            }
+
+            return consumed;
+        }
+
+        // Updates an uninverted CRC-32C with the given bytes, eight at a time where the target is 64-bit
+        // Each instruction waits on the result of the one before, so three lanes are computed side by side and the first two are then advanced past the lanes after them
+        BASE64ENCODING_TARGET("sse4.2,pclmul")
+        static uint32_t Crc32cSse42(uint32_t crc, const uint8_t* pData, size_t length)
+        {
+            size_t offset = 0;
+
+#if defined(__x86_64__) || defined(_M_X64)
+            // The 33 bits left out account for the multiplication and reduction themselves
+            static constexpr uint32_t shiftOneLane = Crc32cPowerOfX(8 * BASE64ENCODING_CRC32C_LANE_LENGTH - 33);
+            static constexpr uint32_t shiftTwoLanes = Crc32cPowerOfX(16 * BASE64ENCODING_CRC32C_LANE_LENGTH - 33);
+
+            for(; offset + 3 * BASE64ENCODING_CRC32C_LANE_LENGTH <= length; offset += 3 * BASE64ENCODING_CRC32C_LANE_LENGTH)
+            {
+                const uint8_t* pLane = pData + offset;
+                uint64_t crc1 = crc;
+                uint64_t crc2 = 0;
+                uint64_t crc3 = 0;
+
+                for(size_t i = 0; i < BASE64ENCODING_CRC32C_LANE_LENGTH; i += 8)
+                {
+                    uint64_t data1;
+                    uint64_t data2;
+                    uint64_t data3;
+                    memcpy(&data1, pLane + i, 8);
+                    memcpy(&data2, pLane + BASE64ENCODING_CRC32C_LANE_LENGTH + i, 8);
+                    memcpy(&data3, pLane + 2 * BASE64ENCODING_CRC32C_LANE_LENGTH + i, 8);
+
+                    crc1 = _mm_crc32_u64(crc1, data1);
+                    crc2 = _mm_crc32_u64(crc2, data2);
+                    crc3 = _mm_crc32_u64(crc3, data3);
+                }
+
+                crc = ShiftCrc32c((uint32_t)crc1, shiftTwoLanes) ^ ShiftCrc32c((uint32_t)crc2, shiftOneLane) ^ (uint32_t)crc3;
+            }
+
+            uint64_t crc64 = crc;
+
+            for(; offset + 8 <= length; offset += 8)
+            {
+                uint64_t data;
+                memcpy(&data, pData + offset, 8);
+                crc64 = _mm_crc32_u64(crc64, data);
+            }
+
+            crc = (uint32_t)crc64;
+#endif
+
+            for(; offset + 4 <= length; offset += 4)
+            {
+                uint32_t data;
+                memcpy(&data, pData + offset, 4);
+                crc = _mm_crc32_u32(crc, data);
+            }
+
+            for(; offset < length; offset++)
+            {
+                crc = _mm_crc32_u8(crc, pData[offset]);
+            }
+
+            return crc;
+        }
+
+#endif // BASE64ENCODING_X86
+};
+
+#endif // Base64EncodingSimd_h
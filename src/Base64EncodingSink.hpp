@@ -0,0 +1,403 @@
+#ifndef Base64EncodingSink_h
+#define Base64EncodingSink_h
+
+#include <string>
+#include <string_view>
+
+#if (defined(_MSVC_LANG) ? _MSVC_LANG : __cplusplus) >= 202002L
+#include <span>
+#endif
+
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
+#include "Base64Encoding.hpp"
+
+// Number of characters a callback sink gathers before each call, a multiple of twelve so that no group is split between calls in either direction
+#define BASE64ENCODING_SINK_BLOCK_LENGTH 4092
+
+// Sinks hand out writable regions for Base64SinkEncoding to write straight into
+// Next returns the length of the next region, at most the given number of characters still to be written is needed, or zero once the sink is full
+// Commit then reports how much of that region was written
+
+// Appends to a std::string, which is grown once by the whole output instead of once per piece
+// Where the standard library provides resize_and_overwrite the new characters are not zero filled first
+class Base64StringSink
+{
+    private:
+
+        std::string& String;
+        size_t CommittedLength;
+
+    public:
+
+        Base64StringSink(std::string& string)
+          : String(string),
+            CommittedLength(string.size())
+        {
+
+        }
+
+        size_t Next(char*& pRegion, size_t length)
+        {
+#ifdef __cpp_lib_string_resize_and_overwrite
+            String.resize_and_overwrite(CommittedLength + length, [](char*, size_t size) { return size; });
+#else
+            String.resize(CommittedLength + length);
+#endif
+
+            pRegion = &String[CommittedLength];
+
+            return length;
+        }
+
+        void Commit(size_t length)
+        {
+            CommittedLength += length;
+
+            // Only shrinks the string, if less was written than the region held
+            String.resize(CommittedLength);
+        }
+};
+
+// Writes into a buffer provided by the caller
+class Base64BufferSink
+{
+    private:
+
+        char* Buffer;
+        size_t BufferLength;
+        size_t WrittenLength;
+
+    public:
+
+        Base64BufferSink(void* pBuffer, size_t bufferLength)
+          : Buffer((char*)pBuffer),
+            BufferLength(bufferLength),
+            WrittenLength(0)
+        {
+
+        }
+
+#ifdef __cpp_lib_span
+        Base64BufferSink(std::span<char> buffer)
+          : Base64BufferSink(buffer.data(), buffer.size())
+        {
+
+        }
+
+        Base64BufferSink(std::span<std::byte> buffer)
+          : Base64BufferSink(buffer.data(), buffer.size())
+        {
+
+        }
+#endif
+
+        // Returns the number of characters written so far
+        size_t Length() const
+        {
+            return WrittenLength;
+        }
+
+        size_t Next(char*& pRegion, size_t)
+        {
+            pRegion = Buffer + WrittenLength;
+
+            return BufferLength - WrittenLength;
+        }
+
+        void Commit(size_t length)
+        {
+            WrittenLength += length;
+        }
+};
+
+#if !defined(_WIN32)
+
+// Scatters the output across a list of buffers, such as those passed to writev or sendmsg, filling each one in turn
+class Base64IovecSink
+{
+    private:
+
+        const struct iovec* Vectors;
+        size_t VectorCount;
+        size_t VectorIndex;
+        size_t VectorOffset;
+        size_t WrittenLength;
+
+    public:
+
+        Base64IovecSink(const struct iovec* pVectors, size_t vectorCount)
+          : Vectors(pVectors),
+            VectorCount(vectorCount),
+            VectorIndex(0),
+            VectorOffset(0),
+            WrittenLength(0)
+        {
+
+        }
+
+        // Returns the number of characters written so far
+        size_t Length() const
+        {
+            return WrittenLength;
+        }
+
+        size_t Next(char*& pRegion, size_t)
+        {
+            while(VectorIndex < VectorCount && VectorOffset == Vectors[VectorIndex].iov_len)
+            {
+                VectorIndex++;
+                VectorOffset = 0;
+            }
+
+            if(VectorIndex == VectorCount)
+            {
+                return 0;
+            }
+
+            pRegion = (char*)Vectors[VectorIndex].iov_base + VectorOffset;
+
+            return Vectors[VectorIndex].iov_len - VectorOffset;
+        }
+
+        void Commit(size_t length)
+        {
+            VectorOffset += length;
+            WrittenLength += length;
+        }
+};
+
+#endif
+
+// Passes the output to a callable taking (const char* pData, size_t length), such as one appending to a container of the caller's choice
+// The output is gathered into a block on the stack and handed over a block at a time
+template<typename TAppender>
+class Base64CallbackSink
+{
+    private:
+
+        TAppender Appender;
+        char Block[BASE64ENCODING_SINK_BLOCK_LENGTH];
+
+    public:
+
+        Base64CallbackSink(TAppender appender)
+          : Appender(appender)
+        {
+
+        }
+
+        size_t Next(char*& pRegion, size_t)
+        {
+            pRegion = Block;
+
+            return sizeof(Block);
+        }
+
+        void Commit(size_t length)
+        {
+            Appender((const char*)Block, length);
+        }
+};
+
+// Encodes from and decodes to views and spans, writing the output straight into a sink
+// Whole groups are written straight into each region the sink hands out, and only a group split between two regions passes through a few bytes on the stack
+class Base64SinkEncoding
+{
+    private:
+
+        Base64Encoding& Encoding;
+
+        template<typename TSink>
+        int64_t EncodeToSink(const uint8_t* pInputBuffer, size_t inputLength, TSink& sink)
+        {
+            // Regions are filled by the length each encode returns, so an encoding that rejects every call is caught first
+            if(!Encoding.IsValid())
+            {
+                return BASE64ENCODING_INVALID_ALPHABET;
+            }
+
+            size_t encodedLength = Encoding.EncodedLength(inputLength);
+
+            if(encodedLength == BASE64ENCODING_LENGTH_OVERFLOW)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            // Characters of a group split between two regions
+            char group[4];
+            size_t groupLength = 0;
+            size_t groupOffset = 0;
+
+            size_t consumed = 0;
+            size_t remainingLength = encodedLength;
+
+            while(remainingLength > 0)
+            {
+                char* pRegion = NULL;
+                size_t regionLength = sink.Next(pRegion, remainingLength);
+                size_t written = 0;
+
+                if(regionLength == 0)
+                {
+                    return BASE64ENCODING_BUFFER_OVERFLOW;
+                }
+
+                if(regionLength > remainingLength)
+                {
+                    regionLength = remainingLength;
+                }
+
+                // Finish the group split at the end of the previous region
+                while(groupOffset < groupLength && written < regionLength)
+                {
+                    pRegion[written++] = group[groupOffset++];
+                }
+
+                // Encode the rest of the input if it fits, otherwise as many whole groups as fit, which never include the final group
+                size_t spaceLength = regionLength - written;
+                size_t chunkLength = spaceLength == remainingLength - written ? inputLength - consumed : (spaceLength / 4) * 3;
+
+                written += (size_t)Encoding.Encode(pInputBuffer + consumed, chunkLength, pRegion + written, spaceLength);
+                consumed += chunkLength;
+
+                // Split the next group between the end of this region and the start of the next
+                if(written < regionLength)
+                {
+                    size_t groupInputLength = inputLength - consumed < 3 ? inputLength - consumed : 3;
+
+                    groupLength = (size_t)Encoding.Encode(pInputBuffer + consumed, groupInputLength, group, sizeof(group));
+                    groupOffset = 0;
+                    consumed += groupInputLength;
+
+                    while(written < regionLength)
+                    {
+                        pRegion[written++] = group[groupOffset++];
+                    }
+                }
+
+                sink.Commit(written);
+                remainingLength -= written;
+            }
+
+            return (int64_t)encodedLength;
+        }
+
+    public:
+
+        Base64SinkEncoding(Base64Encoding& encoding)
+          : Encoding(encoding)
+        {
+
+        }
+
+        // Converts binary data into a Base64 string written to the sink, which is not null terminated
+        // Returns the length of the encoded string or BASE64ENCODING_BUFFER_OVERFLOW if the sink fills up first, in which case the sink holds part of the string
+        template<typename TSink>
+        int64_t Encode(const void* pInputBuffer, size_t inputLength, TSink&& sink)
+        {
+            return EncodeToSink((const uint8_t*)pInputBuffer, inputLength, sink);
+        }
+
+        template<typename TSink>
+        int64_t Encode(std::string_view input, TSink&& sink)
+        {
+            return EncodeToSink((const uint8_t*)input.data(), input.size(), sink);
+        }
+
+#ifdef __cpp_lib_span
+        template<typename TSink>
+        int64_t Encode(std::span<const std::byte> input, TSink&& sink)
+        {
+            return EncodeToSink((const uint8_t*)input.data(), input.size(), sink);
+        }
+#endif
+
+        // Converts a Base64 string into binary data written to the sink
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the sink fills up first
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside the alphabet or padding before its end,
+        // in which case the sink holds part of the data
+        template<typename TSink>
+        int64_t Decode(std::string_view input, TSink&& sink)
+        {
+            const char* pInputBuffer = input.data();
+            size_t inputLength = input.size();
+            size_t decodedLength = Encoding.DecodedLength(pInputBuffer, inputLength);
+
+            // Bytes of a group split between two regions
+            uint8_t group[3];
+            size_t groupLength = 0;
+            size_t groupOffset = 0;
+
+            size_t consumed = 0;
+            size_t remainingLength = decodedLength;
+
+            while(remainingLength > 0)
+            {
+                char* pRegion = NULL;
+                size_t regionLength = sink.Next(pRegion, remainingLength);
+                size_t written = 0;
+
+                if(regionLength == 0)
+                {
+                    return BASE64ENCODING_BUFFER_OVERFLOW;
+                }
+
+                if(regionLength > remainingLength)
+                {
+                    regionLength = remainingLength;
+                }
+
+                // Finish the group split at the end of the previous region
+                while(groupOffset < groupLength && written < regionLength)
+                {
+                    pRegion[written++] = (char)group[groupOffset++];
+                }
+
+                // Decode the rest of the input if it fits, otherwise as many whole groups as fit, which never include the final group
+                size_t spaceLength = regionLength - written;
+                bool finalChunk = spaceLength == remainingLength - written;
+                size_t chunkLength = finalChunk ? inputLength - consumed : (spaceLength / 3) * 4;
+                int64_t chunkDecodedLength = Encoding.Decode(pInputBuffer + consumed, chunkLength, (uint8_t*)pRegion + written, spaceLength);
+
+                // Padding ends the string, so only the final chunk may decode to fewer bytes than its whole groups
+                if(chunkDecodedLength < 0 || (!finalChunk && (size_t)chunkDecodedLength != (chunkLength / 4) * 3))
+                {
+                    return chunkDecodedLength < 0 ? chunkDecodedLength : BASE64ENCODING_INVALID_CHARACTER;
+                }
+
+                written += (size_t)chunkDecodedLength;
+                consumed += chunkLength;
+
+                // Split the next group between the end of this region and the start of the next
+                if(written < regionLength)
+                {
+                    size_t groupInputLength = inputLength - consumed <= 4 ? inputLength - consumed : 4;
+                    int64_t groupDecodedLength = Encoding.Decode(pInputBuffer + consumed, groupInputLength, group, sizeof(group));
+
+                    if(groupDecodedLength < 0 || (groupInputLength == 4 && inputLength - consumed > 4 && groupDecodedLength != 3))
+                    {
+                        return groupDecodedLength < 0 ? groupDecodedLength : BASE64ENCODING_INVALID_CHARACTER;
+                    }
+
+                    groupLength = (size_t)groupDecodedLength;
+                    groupOffset = 0;
+                    consumed += groupInputLength;
+
+                    while(written < regionLength && groupOffset < groupLength)
+                    {
+                        pRegion[written++] = (char)group[groupOffset++];
+                    }
+                }
+
+                sink.Commit(written);
+                remainingLength -= written;
+            }
+
+            return (int64_t)decodedLength;
+        }
+};
+
+#endif // Base64EncodingSink_h
@@ -0,0 +1,248 @@
+#ifndef Base64EncodingStream_h
+#define Base64EncodingStream_h
+
+#include "Base64Encoding.hpp"
+
+// Encodes a stream of binary data delivered in chunks of any length
+// Bytes that do not complete a set of three are carried over to the next chunk, so padding is only written by Finish
+class Base64StreamEncoder
+{
+    private:
+
+        Base64Encoding& Encoding;
+
+        uint8_t Carry[3];
+        uint8_t CarryLength;
+
+    public:
+
+        Base64StreamEncoder(Base64Encoding& encoding)
+          : Encoding(encoding),
+            CarryLength(0)
+        {
+
+        }
+
+        // Returns the largest number of Base64 characters Update can write for a chunk of the given length
+        size_t UpdateLength(size_t inputLength)
+        {
+            return Encoding.EncodedLength(((CarryLength + inputLength) / 3) * 3);
+        }
+
+        // Returns the number of Base64 characters Finish will write
+        size_t FinishLength()
+        {
+            return Encoding.EncodedLength(CarryLength);
+        }
+
+        // Encodes every complete set of three bytes formed by the carried bytes and the chunk
+        // Returns the number of Base64 characters written or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is smaller than UpdateLength
+        int64_t Update(const uint8_t* pInputBuffer, size_t inputLength, char* pOutputBuffer, size_t outputBufferLength)
+        {
+            // The output is advanced by the length each encode returns, so an encoding that rejects every call is caught first
+            if(!Encoding.IsValid())
+            {
+                return BASE64ENCODING_INVALID_ALPHABET;
+            }
+
+            if(outputBufferLength < UpdateLength(inputLength))
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            char* pOutputStart = pOutputBuffer;
+
+            // Complete the set of three bytes carried over from the previous chunk
+            if(CarryLength > 0)
+            {
+                while(CarryLength < 3 && inputLength > 0)
+                {
+                    Carry[CarryLength++] = pInputBuffer[0];
+
+                    pInputBuffer += 1;
+                    inputLength -= 1;
+                }
+
+                if(CarryLength < 3)
+                {
+                    return 0;
+                }
+
+                pOutputBuffer += Encoding.Encode(Carry, 3, pOutputBuffer, 4);
+                CarryLength = 0;
+            }
+
+            // Encode every complete set of three bytes in place and carry over the rest
+            size_t groupedLength = inputLength - (inputLength % 3);
+
+            pOutputBuffer += Encoding.Encode(pInputBuffer, groupedLength, pOutputBuffer, outputBufferLength - (pOutputBuffer - pOutputStart));
+
+            CarryLength = (uint8_t)(inputLength - groupedLength);
+            memcpy(Carry, pInputBuffer + groupedLength, CarryLength);
+
+            return pOutputBuffer - pOutputStart;
+        }
+
+        // Encodes the carried bytes, adding padding if the encoding is padded, and resets the encoder for a new stream
+        // Returns the number of Base64 characters written or BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is smaller than FinishLength
+        int64_t Finish(char* pOutputBuffer, size_t outputBufferLength)
+        {
+            int64_t encodedLength = Encoding.Encode(Carry, CarryLength, pOutputBuffer, outputBufferLength);
+
+            if(encodedLength >= 0)
+            {
+                CarryLength = 0;
+            }
+
+            return encodedLength;
+        }
+
+        // Discards any carried bytes
+        void Reset()
+        {
+            CarryLength = 0;
+        }
+};
+
+// Decodes a stream of Base64 characters delivered in chunks of any length
+// Characters that do not complete a set of four are carried over to the next chunk
+class Base64StreamDecoder
+{
+    private:
+
+        Base64Encoding& Encoding;
+
+        char Carry[4];
+        uint8_t CarryLength;
+
+        // Set once a set of four characters ending in padding has been decoded, after which the stream must end
+        bool PaddingDecoded;
+
+        // Decodes complete sets of four characters, noting whether the last of them was padded
+        int64_t DecodeGroups(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            if(inputLength == 0)
+            {
+                return 0;
+            }
+
+            if(PaddingDecoded)
+            {
+                return BASE64ENCODING_INVALID_CHARACTER;
+            }
+
+            PaddingDecoded = pInputBuffer[inputLength - 1] == '=';
+
+            return Encoding.Decode(pInputBuffer, inputLength, pOutputBuffer, outputBufferLength);
+        }
+
+    public:
+
+        Base64StreamDecoder(Base64Encoding& encoding)
+          : Encoding(encoding),
+            CarryLength(0),
+            PaddingDecoded(false)
+        {
+
+        }
+
+        // Returns the largest number of bytes Update can write for a chunk of the given length
+        size_t UpdateLength(size_t inputLength)
+        {
+            return ((CarryLength + inputLength) / 4) * 3;
+        }
+
+        // Returns the number of bytes Finish will write
+        size_t FinishLength()
+        {
+            return Encoding.DecodedLength(Carry, CarryLength);
+        }
+
+        // Decodes every complete set of four characters formed by the carried characters and the chunk
+        // Returns the number of bytes written, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is smaller than UpdateLength
+        // or BASE64ENCODING_INVALID_CHARACTER if the chunk contains a character outside the alphabet or data follows padding
+        int64_t Update(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            if(outputBufferLength < UpdateLength(inputLength))
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            uint8_t* pOutputStart = pOutputBuffer;
+            int64_t decodedLength;
+
+            // Complete the set of four characters carried over from the previous chunk
+            if(CarryLength > 0)
+            {
+                while(CarryLength < 4 && inputLength > 0)
+                {
+                    Carry[CarryLength++] = pInputBuffer[0];
+
+                    pInputBuffer += 1;
+                    inputLength -= 1;
+                }
+
+                if(CarryLength < 4)
+                {
+                    return 0;
+                }
+
+                decodedLength = DecodeGroups(Carry, 4, pOutputBuffer, 3);
+
+                if(decodedLength < 0)
+                {
+                    return decodedLength;
+                }
+
+                pOutputBuffer += decodedLength;
+                CarryLength = 0;
+            }
+
+            // Decode every complete set of four characters in place and carry over the rest
+            size_t groupedLength = inputLength - (inputLength % 4);
+
+            decodedLength = DecodeGroups(pInputBuffer, groupedLength, pOutputBuffer, outputBufferLength - (pOutputBuffer - pOutputStart));
+
+            if(decodedLength < 0)
+            {
+                return decodedLength;
+            }
+
+            pOutputBuffer += decodedLength;
+
+            CarryLength = (uint8_t)(inputLength - groupedLength);
+            memcpy(Carry, pInputBuffer + groupedLength, CarryLength);
+
+            return pOutputBuffer - pOutputStart;
+        }
+
+        // Decodes the carried characters as the final, unpadded, set and resets the decoder for a new stream
+        // Returns the number of bytes written, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is smaller than FinishLength
+        // or BASE64ENCODING_INVALID_CHARACTER if the carried characters are not valid, or the stream is padded and ends partway through a set of four
+        int64_t Finish(uint8_t* pOutputBuffer, size_t outputBufferLength)
+        {
+            // A padded stream is a whole number of sets of four, so a carried tail means it was truncated rather than a final group to drop
+            if(CarryLength > 0 && BIT_IS_SET(Encoding.GetOptions(), Base64EncodingOptions::Padded))
+            {
+                return BASE64ENCODING_INVALID_CHARACTER;
+            }
+
+            int64_t decodedLength = DecodeGroups(Carry, CarryLength, pOutputBuffer, outputBufferLength);
+
+            if(decodedLength >= 0)
+            {
+                Reset();
+            }
+
+            return decodedLength;
+        }
+
+        // Discards any carried characters and padding state
+        void Reset()
+        {
+            CarryLength = 0;
+            PaddingDecoded = false;
+        }
+};
+
+#endif // Base64EncodingStream_h
@@ -0,0 +1,221 @@
+#ifndef Base64EncodingVariant_h
+#define Base64EncodingVariant_h
+
+#include "Base64Encoding.hpp"
+
+// Marks carried above the sextet by the entries of Base64EitherAlphabet for the 62nd and 63rd characters of each alphabet
+// Characters outside both alphabets carry both marks
+#define BASE64ENCODING_VARIANT_STANDARD_MARK 0x40
+#define BASE64ENCODING_VARIANT_URL_SAFE_MARK 0x80
+#define BASE64ENCODING_VARIANT_SEXTET_MASK 0x3F
+
+// Alphabet seen by Base64VariantDecoding, as flags
+typedef enum
+{
+    // Neither the 62nd nor the 63rd character of either alphabet appeared, so the input decodes the same with both
+    Base64VariantEitherAlphabet = 0x00,
+    Base64VariantStandardAlphabet = 0x01,
+    Base64VariantUrlSafeAlphabet = 0x02,
+
+    // Characters of both alphabets appeared, which no single encoder produces
+    Base64VariantMixedAlphabets = 0x03
+} Base64AlphabetVariant;
+
+struct Base64DecodedVariant
+{
+    Base64AlphabetVariant Alphabet;
+
+    // Whether the input ended in padding characters
+    bool Padded;
+};
+
+// Character to sextet table of the standard alphabet that also accepts the 62nd and 63rd characters of the URL and filename safe one
+// '+' and '-' both decode to 62 and '/' and '_' both to 63, with BASE64ENCODING_VARIANT_STANDARD_MARK or BASE64ENCODING_VARIANT_URL_SAFE_MARK set above the sextet
+struct Base64EitherAlphabet
+{
+    uint8_t DecodeTable[256];
+
+    constexpr Base64EitherAlphabet()
+      : DecodeTable()
+    {
+        for(size_t character = 0; character < 256; character++)
+        {
+            uint8_t sextet = Base64AlphabetRegistry::Standard.DecodeTable[character];
+
+            DecodeTable[character] = sextet == BASE64ENCODING_INVALID_SEXTET ? BASE64ENCODING_VARIANT_STANDARD_MARK | BASE64ENCODING_VARIANT_URL_SAFE_MARK : sextet;
+        }
+
+        DecodeTable[(uint8_t)'+'] = 62 | BASE64ENCODING_VARIANT_STANDARD_MARK;
+        DecodeTable[(uint8_t)'/'] = 63 | BASE64ENCODING_VARIANT_STANDARD_MARK;
+        DecodeTable[(uint8_t)'-'] = 62 | BASE64ENCODING_VARIANT_URL_SAFE_MARK;
+        DecodeTable[(uint8_t)'_'] = 63 | BASE64ENCODING_VARIANT_URL_SAFE_MARK;
+    }
+};
+
+// Decodes input in either the standard or the URL and filename safe alphabet of RFC 4648, padded or not, in a single pass
+// and reports which was seen, instead of decoding with one Base64Encoding and retrying with another when that fails
+// The marks of every entry looked up are ORed together as the input is decoded, by the marked vectorized kernels and the scalar loop alike,
+// so the variant is known without scanning the input again
+class Base64VariantDecoding
+{
+    private:
+
+        typedef Base64EncodingCore<false> Core;
+
+        static constexpr Base64EitherAlphabet Alphabet = Base64EitherAlphabet();
+
+        // Instruction set used for the bulk of each decode
+        Base64EncodingKernel Kernel;
+
+        // Returns the length of the input before any padding, which may only end a whole number of groups
+        static size_t UnpaddedLength(const char* pInputBuffer, size_t inputLength)
+        {
+            if(inputLength == 0 || inputLength % 4 != 0 || pInputBuffer[inputLength - 1] != '=')
+            {
+                return inputLength;
+            }
+
+            return pInputBuffer[inputLength - 2] == '=' ? inputLength - 2 : inputLength - 1;
+        }
+
+        // Decodes the leading groups of four characters with the marked kernel of the selected instruction set, and adds the marks seen to found
+        // Returns the number of input characters consumed, the remainder is left to the scalar loop
+        size_t DecodeVectorized(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, uint32_t& found)
+        {
+            switch(Kernel)
+            {
+#ifdef BASE64ENCODING_X86
+                case Base64EncodingKernel::Base64KernelAvx512Vbmi:
+                    return Base64EncodingSimd::DecodeMarkedAvx512Vbmi(pInputBuffer, inputLength, pOutputBuffer, Alphabet.DecodeTable, found);
+
+                case Base64EncodingKernel::Base64KernelAvx2:
+                    return Base64EncodingSimd::DecodeMarkedAvx2(pInputBuffer, inputLength, pOutputBuffer, Alphabet.DecodeTable, found);
+
+                case Base64EncodingKernel::Base64KernelSsse3:
+                    return Base64EncodingSimd::DecodeMarkedSsse3(pInputBuffer, inputLength, pOutputBuffer, Alphabet.DecodeTable, found);
+#endif
+
+                default:
+                    return 0;
+            }
+        }
+
+        // Decodes whole groups of four characters with the lookup table
+        // Returns every entry looked up ORed together, with bit 8 also set if any character is outside both alphabets
+        static uint32_t DecodeScalar(const char* pInputBuffer, size_t groupCount, uint8_t* pOutputBuffer)
+        {
+            uint32_t entries = 0;
+            uint32_t invalid = 0;
+
+            for(size_t i = 0; i < groupCount; i++)
+            {
+                uint32_t entry1 = Alphabet.DecodeTable[(uint8_t)pInputBuffer[0]];
+                uint32_t entry2 = Alphabet.DecodeTable[(uint8_t)pInputBuffer[1]];
+                uint32_t entry3 = Alphabet.DecodeTable[(uint8_t)pInputBuffer[2]];
+                uint32_t entry4 = Alphabet.DecodeTable[(uint8_t)pInputBuffer[3]];
+
+                entries |= entry1 | entry2 | entry3 | entry4;
+
+                // Only an entry carrying both marks keeps its top bit once ANDed with itself shifted up by one
+                invalid |= (entry1 & entry1 << 1) | (entry2 & entry2 << 1) | (entry3 & entry3 << 1) | (entry4 & entry4 << 1);
+
+                uint32_t characterSet = (entry1 & BASE64ENCODING_VARIANT_SEXTET_MASK) << 18 | (entry2 & BASE64ENCODING_VARIANT_SEXTET_MASK) << 12
+                                      | (entry3 & BASE64ENCODING_VARIANT_SEXTET_MASK) << 6 | (entry4 & BASE64ENCODING_VARIANT_SEXTET_MASK);
+
+                pOutputBuffer[0] = characterSet >> 16;
+                pOutputBuffer[1] = (characterSet & BASE64ENCODING_OCTET2_MASK) >> 8;
+                pOutputBuffer[2] = (characterSet & BASE64ENCODING_OCTET3_MASK);
+
+                pInputBuffer += 4;
+                pOutputBuffer += 3;
+            }
+
+            return entries | (invalid & BASE64ENCODING_VARIANT_URL_SAFE_MARK) << 1;
+        }
+
+    public:
+
+        Base64VariantDecoding()
+          : Kernel(Base64EncodingSimd::SupportedKernel())
+        {
+
+        }
+
+        // Returns the instruction set currently used by Decode
+        Base64EncodingKernel GetKernel()
+        {
+            return Kernel;
+        }
+
+        // Restricts Decode to the given instruction set
+        // Returns false and leaves the current kernel unchanged if the processor does not support it
+        bool SetKernel(Base64EncodingKernel kernel)
+        {
+            if(kernel > Base64EncodingSimd::SupportedKernel())
+            {
+                return false;
+            }
+
+            Kernel = kernel;
+
+            return true;
+        }
+
+        // Returns the length of the binary data the input decodes to, whether or not it is padded
+        size_t DecodedLength(const char* pInputBuffer, size_t inputLength)
+        {
+            return Core::DecodedLength(pInputBuffer, UnpaddedLength(pInputBuffer, inputLength));
+        }
+
+        // Converts a Base64 string of the given length in either alphabet, padded or not, into binary data and sets the variant seen
+        // Returns the length of the decoded data, BASE64ENCODING_BUFFER_OVERFLOW if the output buffer is not large enough to hold the decoded data
+        // or BASE64ENCODING_INVALID_CHARACTER if the input contains a character outside both alphabets or padding anywhere but the end of the final group,
+        // in which case the variant is left unchanged
+        // Input mixing the two alphabets is decoded and reported as Base64VariantMixedAlphabets, for the caller to reject if it must
+        // Only the characters decoded are looked at, so a lone character left after the final group, which holds no whole byte, does not count towards the variant
+        int64_t Decode(const char* pInputBuffer, size_t inputLength, uint8_t* pOutputBuffer, size_t outputBufferLength, Base64DecodedVariant& variant)
+        {
+            size_t unpaddedLength = UnpaddedLength(pInputBuffer, inputLength);
+            size_t decodedLength = Core::DecodedLength(pInputBuffer, unpaddedLength);
+            size_t groupedLength = (decodedLength / 3) * 4;
+            uint32_t found = 0;
+
+            // Verify the output buffer is large enough to hold the decoded data
+            if(outputBufferLength < decodedLength)
+            {
+                return BASE64ENCODING_BUFFER_OVERFLOW;
+            }
+
+            // The kernel stores whole vectors, so it is only given the whole groups, whose decoded bytes leave room for them
+            size_t vectorizedLength = DecodeVectorized(pInputBuffer, groupedLength, pOutputBuffer, found);
+            uint32_t entries = DecodeScalar(pInputBuffer + vectorizedLength, (groupedLength - vectorizedLength) / 4, pOutputBuffer + (vectorizedLength / 4) * 3);
+
+            // Two or three characters not grouped into a set of four are completed with 'A', which decodes to zero bits and carries no mark
+            if(decodedLength % 3 != 0)
+            {
+                char group[4] = { 'A', 'A', 'A', 'A' };
+                uint8_t decodedGroup[3];
+
+                memcpy(group, pInputBuffer + groupedLength, decodedLength % 3 + 1);
+
+                entries |= DecodeScalar(group, 1, decodedGroup);
+
+                memcpy(pOutputBuffer + (groupedLength / 4) * 3, decodedGroup, decodedLength % 3);
+            }
+
+            if(entries > 0xFF)
+            {
+                return BASE64ENCODING_INVALID_CHARACTER;
+            }
+
+            found |= (entries & BASE64ENCODING_VARIANT_STANDARD_MARK ? Base64AlphabetVariant::Base64VariantStandardAlphabet : 0)
+                   | (entries & BASE64ENCODING_VARIANT_URL_SAFE_MARK ? Base64AlphabetVariant::Base64VariantUrlSafeAlphabet : 0);
+
+            variant.Alphabet = (Base64AlphabetVariant)found;
+            variant.Padded = unpaddedLength < inputLength;
+
+            return (int64_t)decodedLength;
+        }
+};
+
+#endif // Base64EncodingVariant_h
@@ -1,10 +1,219 @@
 #include "CppUnitTest.h"
-#include "../src/Base64Encoding.h"
+#include "../src/Base64Encoding.hpp"
+#include "../src/Base64EncodingChecksum.hpp"
+#include "../src/Base64EncodingParallel.hpp"
+#include "../src/Base64EncodingPipeline.hpp"
+#include "../src/Base64EncodingSink.hpp"
+#include "../src/Base64EncodingStream.hpp"
+#include "../src/Base64EncodingVariant.hpp"
+
+#if !defined(_WIN32)
+#include "../src/Base64EncodingFile.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 namespace Base64EncodingTests
 {
+#if !defined(_WIN32) && SIZE_MAX > UINT32_MAX
+
+	// Size of the physical block repeated throughout a large mapping
+	const size_t RepeatedBlockLength = 1 << 20;
+
+	// Maps a region of the given length in which every block aliases the same physical memory, filled with the given byte
+	// Allows buffers larger than 4 GB to be read and written without committing more than a single block of memory
+	uint8_t* MapRepeatedBlock(size_t length, uint8_t fill)
+	{
+		char path[] = "/tmp/Base64EncodingTestsXXXXXX";
+		int file = mkstemp(path);
+
+		if(file < 0)
+		{
+			return NULL;
+		}
+
+		unlink(path);
+
+		size_t mappedLength = ((length + RepeatedBlockLength - 1) / RepeatedBlockLength) * RepeatedBlockLength;
+		uint8_t* pRegion = (uint8_t*)mmap(NULL, mappedLength, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+		if(ftruncate(file, RepeatedBlockLength) != 0 || pRegion == MAP_FAILED)
+		{
+			close(file);
+			return NULL;
+		}
+
+		for(size_t offset = 0; offset < mappedLength; offset += RepeatedBlockLength)
+		{
+			if(mmap(pRegion + offset, RepeatedBlockLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, file, 0) == MAP_FAILED)
+			{
+				munmap(pRegion, mappedLength);
+				close(file);
+				return NULL;
+			}
+		}
+
+		close(file);
+		memset(pRegion, fill, RepeatedBlockLength);
+
+		return pRegion;
+	}
+
+	void UnmapRepeatedBlock(uint8_t* pRegion, size_t length)
+	{
+		munmap(pRegion, ((length + RepeatedBlockLength - 1) / RepeatedBlockLength) * RepeatedBlockLength);
+	}
+
+#endif
+
+#if !defined(_WIN32)
+
+	// Replaces the contents of the file with the given data
+	void WriteTestFile(const char* pPath, const void* pData, size_t length)
+	{
+		FILE* pFile = fopen(pPath, "wb");
+
+		Assert::IsTrue(pFile != NULL);
+		Assert::AreEqual(length, fwrite(pData, 1, length, pFile));
+
+		fclose(pFile);
+	}
+
+	// Reads up to the given number of bytes from the start of the file
+	// Returns the number of bytes read
+	size_t ReadTestFile(const char* pPath, void* pData, size_t length)
+	{
+		FILE* pFile = fopen(pPath, "rb");
+
+		Assert::IsTrue(pFile != NULL);
+
+		size_t readLength = fread(pData, 1, length, pFile);
+
+		fclose(pFile);
+
+		return readLength;
+	}
+
+#endif
+
+#ifdef BASE64ENCODING_INSTRUMENTATION
+
+	// Calls seen by the trace hook
+	size_t TracedCallCount = 0;
+	int64_t TracedResult = 0;
+
+	void TraceCall(const Base64TraceEvent& event)
+	{
+		TracedCallCount++;
+		TracedResult = event.Result;
+	}
+
+	// Sums the exported counters of every operation and kernel by name
+	class SummingExporter : public Base64MetricsExporter
+	{
+	public:
+		uint64_t Calls = 0;
+		uint64_t InvalidInputs = 0;
+		uint64_t HistogramTotal = 0;
+
+		void ExportCounter(const char* pName, Base64MetricsOperation, Base64EncodingKernel, uint64_t value) override
+		{
+			if (strcmp(pName, "calls") == 0)
+			{
+				Calls += value;
+			}
+			else if (strcmp(pName, "invalid_inputs") == 0)
+			{
+				InvalidInputs += value;
+			}
+		}
+
+		void ExportHistogram(const char*, Base64MetricsOperation, Base64EncodingKernel, const uint64_t* pBuckets, size_t bucketCount) override
+		{
+			for (size_t bucket = 0; bucket < bucketCount; bucket++)
+			{
+				HistogramTotal += pBuckets[bucket];
+			}
+		}
+	};
+
+#endif
+
+	// Verifies a compile-time codec produces the same output as the runtime encoding with the matching configuration
+	template<typename Codec>
+	void AssertCodecMatchesEncoding(Base64Encoding& base64)
+	{
+		uint8_t testData[1000];
+		char encodeBuffer[1400];
+		char codecEncodeBuffer[1400];
+		uint8_t codecDecodeBuffer[1000];
+
+		for (size_t i = 0; i < sizeof(testData); ++i)
+		{
+			testData[i] = (uint8_t)(i * 7 + (i >> 3));
+		}
+
+		for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 37)
+		{
+			int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+			int64_t codecEncodeLength = Codec::Encode(testData, testDataLength, codecEncodeBuffer, sizeof(codecEncodeBuffer));
+
+			Assert::AreEqual(encodeLength, codecEncodeLength);
+			Assert::AreEqual((size_t)encodeLength, Codec::EncodedLength(testDataLength));
+			Assert::AreEqual(0, memcmp(encodeBuffer, codecEncodeBuffer, (size_t)encodeLength));
+
+			int64_t codecDecodeLength = Codec::Decode(codecEncodeBuffer, (size_t)codecEncodeLength, codecDecodeBuffer, sizeof(codecDecodeBuffer));
+
+			Assert::AreEqual((int64_t)testDataLength, codecDecodeLength);
+			Assert::AreEqual(0, memcmp(testData, codecDecodeBuffer, testDataLength));
+		}
+	}
+
+	// Copies a Base64 string into the output, breaking it into lines of the given length ended by the given line break
+	// Returns the length of the wrapped string
+	size_t WrapLines(const char* pInput, size_t inputLength, size_t lineLength, const char* pLineBreak, char* pOutput)
+	{
+		size_t outputLength = 0;
+
+		for (size_t i = 0; i < inputLength; i += lineLength)
+		{
+			size_t length = inputLength - i < lineLength ? inputLength - i : lineLength;
+
+			memcpy(pOutput + outputLength, pInput + i, length);
+			outputLength += length;
+
+			memcpy(pOutput + outputLength, pLineBreak, strlen(pLineBreak));
+			outputLength += strlen(pLineBreak);
+		}
+
+		return outputLength;
+	}
+
+	// Compares an array built at compile time with a string literal, excluding its null terminator
+	template<typename T, size_t Length, size_t ExpectedSize>
+	constexpr bool ConstantEquals(const std::array<T, Length>& constant, const char (&expected)[ExpectedSize])
+	{
+		if(Length != ExpectedSize - 1)
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < Length; ++i)
+		{
+			if((uint8_t)constant[i] != (uint8_t)expected[i])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	TEST_CLASS(Base64EncodingTests)
 	{
 	public:
@@ -424,5 +633,2351 @@ namespace Base64EncodingTests
 			delete[] encodeBuffer;
 			delete[] decodeBuffer;
 		}
+
+		TEST_METHOD(EncodeHighBytesWithPadding)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+			char* testString = "\xff\xfe";
+			int testStringLength = strlen(testString);
+			int encodeBufferRequiredLength;
+			char* encodeBuffer;
+
+			// Encode
+			encodeBufferRequiredLength = base64.EncodedLength(testStringLength) + 1;
+			encodeBuffer = new char[encodeBufferRequiredLength];
+
+			int encodeLength = base64.Encode(testString, encodeBuffer, encodeBufferRequiredLength);
+
+			Assert::AreEqual(4, encodeLength);
+			Assert::AreEqual("//4=", encodeBuffer);
+
+			delete[] encodeBuffer;
+		}
+
+		TEST_METHOD(EncodeAndDecodeCustomCharacters)
+		{
+			Base64Encoding base64('-', '_', Base64EncodingOptions::Unpadded);
+
+			char* testString = "\xfb\xff\xbf";
+			int testStringLength = strlen(testString);
+			int encodeBufferRequiredLength;
+			char* encodeBuffer;
+			int decodeBufferRequiredLength;
+			char* decodeBuffer;
+
+			// Encode
+			encodeBufferRequiredLength = base64.EncodedLength(testStringLength) + 1;
+			encodeBuffer = new char[encodeBufferRequiredLength];
+
+			int encodeLength = base64.Encode(testString, encodeBuffer, encodeBufferRequiredLength);
+
+			Assert::AreEqual(4, encodeLength);
+			Assert::AreEqual("-_-_", encodeBuffer);
+
+			// Decode
+			decodeBufferRequiredLength = base64.DecodedLength(encodeBuffer, encodeLength) + 1;
+			decodeBuffer = new char[decodeBufferRequiredLength];
+
+			int decodeLength = base64.Decode(encodeBuffer, decodeBuffer, decodeBufferRequiredLength);
+
+			Assert::AreEqual(3, decodeLength);
+			Assert::AreEqual((const char*)testString, (const char*)decodeBuffer);
+
+			delete[] encodeBuffer;
+			delete[] decodeBuffer;
+		}
+
+		TEST_METHOD(EncodeAndDecodeNamedAlphabets)
+		{
+			struct
+			{
+				const char* Alphabet;
+				const uint8_t* Input;
+				size_t InputLength;
+				const char* Expected;
+			}
+			vectors[] = { { BASE64ENCODING_BCRYPT_ALPHABET, (const uint8_t*)"Hello, World!?>", 15, "QETqZE6qGDbtakviGR68" },
+			              { BASE64ENCODING_CRYPT_ALPHABET, (const uint8_t*)"Hello, World!?>", 15, "G4JgP4wg63RjQalY6Hwy" },
+			              { BASE64ENCODING_IMAP_ALPHABET, (const uint8_t*)"\xfb\xff\xbf", 3, "+,+," },
+			              { BASE64ENCODING_URL_SAFE_ALPHABET, (const uint8_t*)"\xfb\xff\xbf", 3, "-_-_" } };
+
+			for (auto& vector : vectors)
+			{
+				Base64Encoding base64(vector.Alphabet, Base64EncodingOptions::Unpadded);
+				char encodeBuffer[32];
+				uint8_t decodeBuffer[32];
+
+				int64_t encodeLength = base64.Encode(vector.Input, vector.InputLength, encodeBuffer, sizeof(encodeBuffer));
+
+				Assert::AreEqual((int64_t)strlen(vector.Expected), encodeLength);
+				Assert::AreEqual(0, memcmp(vector.Expected, encodeBuffer, (size_t)encodeLength));
+
+				Assert::AreEqual((int64_t)vector.InputLength, base64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, sizeof(decodeBuffer)));
+				Assert::AreEqual(0, memcmp(vector.Input, decodeBuffer, vector.InputLength));
+			}
+		}
+
+		TEST_METHOD(NamedAlphabetsMatchStandardForEveryKernel)
+		{
+			uint8_t testData[2000];
+			char standardBuffer[2700];
+			char expectedBuffer[2700];
+			char encodeBuffer[2700];
+			char wrappedBuffer[2800];
+			char lineBuffer[2800];
+			uint8_t decodeBuffer[2000];
+			uint32_t seed = 97531;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			const char* alphabets[] = { BASE64ENCODING_STANDARD_ALPHABET, BASE64ENCODING_URL_SAFE_ALPHABET, BASE64ENCODING_IMAP_ALPHABET, BASE64ENCODING_BCRYPT_ALPHABET, BASE64ENCODING_CRYPT_ALPHABET };
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (const char* alphabet : alphabets)
+			{
+				for (Base64EncodingOptions option : options)
+				{
+					Base64Encoding standardBase64('+', '/', option);
+					Base64Encoding base64(alphabet, option);
+					Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+					standardBase64.SetKernel(Base64EncodingKernel::Base64KernelScalar);
+
+					for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 37)
+					{
+						// The expected string is the standard one with each character replaced by the one in the same position of the alphabet
+						int64_t expectedLength = standardBase64.Encode(testData, testDataLength, standardBuffer, sizeof(standardBuffer));
+
+						for (int64_t i = 0; i < expectedLength; ++i)
+						{
+							expectedBuffer[i] = standardBuffer[i] == '=' ? '=' : alphabet[strchr(BASE64ENCODING_STANDARD_ALPHABET, standardBuffer[i]) - BASE64ENCODING_STANDARD_ALPHABET];
+						}
+
+						size_t wrappedLength = WrapLines(expectedBuffer, (size_t)expectedLength, 76, "\r\n", wrappedBuffer);
+
+						for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+						{
+							Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+							Assert::AreEqual(expectedLength, base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer)));
+							Assert::AreEqual(0, memcmp(expectedBuffer, encodeBuffer, (size_t)expectedLength));
+
+							Assert::AreEqual((int64_t)testDataLength, base64.Decode(expectedBuffer, (size_t)expectedLength, decodeBuffer, sizeof(decodeBuffer)));
+							Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+
+							// Line-wrapped encoding and decoding fall back from the line kernels for alphabets outside the standard layout
+							int64_t lineLength = base64.Encode(testData, testDataLength, lineBuffer, sizeof(lineBuffer), 76, Base64LineBreak::Base64LineBreakCrlf);
+
+							Assert::AreEqual((int64_t)wrappedLength - (wrappedLength > 0 ? 2 : 0), lineLength);
+							Assert::AreEqual(0, memcmp(wrappedBuffer, lineBuffer, wrappedLength - (wrappedLength > 0 ? 2 : 0)));
+
+							Assert::AreEqual((int64_t)testDataLength, base64.DecodeIgnoringWhitespace(wrappedBuffer, wrappedLength, decodeBuffer, sizeof(decodeBuffer)));
+							Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+
+							// No alphabet holds an asterisk
+							if (expectedLength > 100)
+							{
+								char savedCharacter = expectedBuffer[90];
+								expectedBuffer[90] = '*';
+
+								Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, base64.Decode(expectedBuffer, (size_t)expectedLength, decodeBuffer, sizeof(decodeBuffer)));
+
+								expectedBuffer[90] = savedCharacter;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(AlphabetsAreInterned)
+		{
+			Base64Encoding standardBase64('+', '/', Base64EncodingOptions::Padded);
+			Base64Encoding unpaddedBase64(BASE64ENCODING_STANDARD_ALPHABET, Base64EncodingOptions::Unpadded);
+			Base64Encoding bcryptBase64(BASE64ENCODING_BCRYPT_ALPHABET, Base64EncodingOptions::Unpadded);
+
+			size_t alphabetCount = Base64AlphabetRegistry::Count();
+
+			Base64Encoding otherBcryptBase64(BASE64ENCODING_BCRYPT_ALPHABET, Base64EncodingOptions::Padded);
+
+			Assert::IsTrue(&standardBase64.GetAlphabet() == &unpaddedBase64.GetAlphabet());
+			Assert::IsTrue(&bcryptBase64.GetAlphabet() == &otherBcryptBase64.GetAlphabet());
+			Assert::IsTrue(&standardBase64.GetAlphabet() != &bcryptBase64.GetAlphabet());
+			Assert::AreEqual(alphabetCount, Base64AlphabetRegistry::Count());
+
+			Assert::IsTrue(standardBase64.GetAlphabet().StandardLayout);
+			Assert::IsFalse(bcryptBase64.GetAlphabet().StandardLayout);
+
+			// The predefined alphabets are constants rather than registry entries
+			Assert::IsTrue(&standardBase64.GetAlphabet() == &Base64AlphabetRegistry::Standard);
+			Assert::IsTrue(&bcryptBase64.GetAlphabet() == &Base64AlphabetRegistry::Bcrypt);
+			Assert::IsTrue(Base64AlphabetRegistry::Intern('-', '_') == &Base64AlphabetRegistry::UrlSafe);
+
+			// An alphabet repeating a character cannot be decoded, so it is not interned
+			char repeatedAlphabet[65];
+			memcpy(repeatedAlphabet, BASE64ENCODING_CRYPT_ALPHABET, 65);
+			repeatedAlphabet[63] = 'A';
+
+			Assert::IsTrue(Base64AlphabetRegistry::Intern(repeatedAlphabet) == NULL);
+			Assert::AreEqual(alphabetCount, Base64AlphabetRegistry::Count());
+		}
+
+		TEST_METHOD(InvalidAlphabetsAreRejected)
+		{
+			const uint8_t testData[] = { 0xFB, 0xFF, 0x00 };
+			char encodeBuffer[16];
+			uint8_t decodeBuffer[16];
+
+			Base64Encoding letterBase64('A', '/', Base64EncodingOptions::Padded);
+			Base64Encoding sameBase64('+', '+', Base64EncodingOptions::Unpadded);
+			Base64Encoding paddingBase64('+', '=', Base64EncodingOptions::Padded);
+			Base64Encoding unpaddedBase64('+', '=', Base64EncodingOptions::Unpadded);
+			Base64Encoding controlBase64('\t', '/', Base64EncodingOptions::Padded);
+			Base64Encoding highBase64('+', (char)0xE9, Base64EncodingOptions::Padded);
+
+			Assert::IsFalse(letterBase64.IsValid());
+			Assert::IsFalse(sameBase64.IsValid());
+			Assert::IsFalse(paddingBase64.IsValid());
+			Assert::IsTrue(unpaddedBase64.IsValid());
+			Assert::IsFalse(controlBase64.IsValid());
+			Assert::IsFalse(highBase64.IsValid());
+
+			// Every call on an invalid encoding fails rather than producing output that does not round trip
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_ALPHABET, letterBase64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer)));
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_ALPHABET, letterBase64.Decode("+/8A", 4, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_ALPHABET, paddingBase64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer)));
+
+			Base64StreamEncoder encoder(letterBase64);
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_ALPHABET, encoder.Update(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer)));
+
+			Base64ParallelEncoding parallelBase64(letterBase64);
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_ALPHABET, parallelBase64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer)));
+
+			// An unpadded alphabet may use '=' as a character
+			Assert::AreEqual((int64_t)4, unpaddedBase64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer)));
+			Assert::AreEqual(0, memcmp(encodeBuffer, "+=8A", 4));
+			Assert::AreEqual((int64_t)3, unpaddedBase64.Decode(encodeBuffer, 4, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual(0, memcmp(decodeBuffer, testData, 3));
+
+			// Full alphabets are read as 64 characters, so a NUL among them is rejected like any other control character
+			char shortAlphabet[65];
+			memcpy(shortAlphabet, BASE64ENCODING_STANDARD_ALPHABET, 65);
+			shortAlphabet[40] = '\0';
+
+			Assert::IsFalse(Base64Encoding(shortAlphabet, Base64EncodingOptions::Unpadded).IsValid());
+		}
+
+		TEST_METHOD(DecodeEitherVariantForEveryKernel)
+		{
+			const size_t testDataLength = 10000;
+
+			uint8_t* testData = new uint8_t[testDataLength];
+			char* encodeBuffer = new char[testDataLength * 2];
+			uint8_t* decodeBuffer = new uint8_t[testDataLength];
+			uint32_t seed = 86420;
+
+			for (size_t i = 0; i < testDataLength; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			struct
+			{
+				char Character62;
+				char Character63;
+				Base64EncodingOptions Options;
+				Base64AlphabetVariant Alphabet;
+			}
+			variants[] = { { '+', '/', Base64EncodingOptions::Padded, Base64AlphabetVariant::Base64VariantStandardAlphabet },
+			               { '+', '/', Base64EncodingOptions::Unpadded, Base64AlphabetVariant::Base64VariantStandardAlphabet },
+			               { '-', '_', Base64EncodingOptions::Padded, Base64AlphabetVariant::Base64VariantUrlSafeAlphabet },
+			               { '-', '_', Base64EncodingOptions::Unpadded, Base64AlphabetVariant::Base64VariantUrlSafeAlphabet } };
+
+			Base64VariantDecoding variantBase64;
+			Base64EncodingKernel supportedKernel = variantBase64.GetKernel();
+
+			for (auto& variant : variants)
+			{
+				Base64Encoding base64(variant.Character62, variant.Character63, variant.Options);
+
+				// Lengths needing no, one and two padding characters, and one leaving most of a vector to the scalar loop
+				size_t lengths[] = { testDataLength, testDataLength - 1, testDataLength - 2, 3073 };
+
+				for (size_t length : lengths)
+				{
+					int64_t encodeLength = base64.Encode(testData, length, encodeBuffer, testDataLength * 2);
+
+					Assert::AreEqual(length, variantBase64.DecodedLength(encodeBuffer, (size_t)encodeLength));
+
+					for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+					{
+						Assert::IsTrue(variantBase64.SetKernel((Base64EncodingKernel)kernel));
+
+						Base64DecodedVariant decodedVariant = {};
+
+						Assert::AreEqual((int64_t)length, variantBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, length, decodedVariant));
+						Assert::AreEqual(0, memcmp(testData, decodeBuffer, length));
+						Assert::IsTrue(decodedVariant.Alphabet == variant.Alphabet);
+						Assert::AreEqual(variant.Options == Base64EncodingOptions::Padded && length % 3 != 0, decodedVariant.Padded);
+
+						Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, variantBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, length - 1, decodedVariant));
+					}
+				}
+			}
+
+			// A character of the other alphabet is found wherever it lies, whether decoded by a kernel or by the scalar loop
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, testDataLength * 2);
+			char* pCharacter63 = strchr(encodeBuffer + 5000, '/');
+			*pCharacter63 = '_';
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(variantBase64.SetKernel((Base64EncodingKernel)kernel));
+
+				Base64DecodedVariant decodedVariant = {};
+
+				Assert::AreEqual((int64_t)testDataLength, variantBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength, decodedVariant));
+				Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+				Assert::IsTrue(decodedVariant.Alphabet == Base64AlphabetVariant::Base64VariantMixedAlphabets);
+			}
+
+			*pCharacter63 = '/';
+
+			// The final whole group is always left to the scalar loop, and here holds both alphabets at once
+			char savedGroup[4];
+			memcpy(savedGroup, encodeBuffer + encodeLength - 8, 4);
+			memcpy(encodeBuffer + encodeLength - 8, "+/-_", 4);
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(variantBase64.SetKernel((Base64EncodingKernel)kernel));
+
+				Base64DecodedVariant decodedVariant = {};
+
+				Assert::AreEqual((int64_t)testDataLength, variantBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength, decodedVariant));
+				Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength - 4));
+				Assert::AreEqual(0, memcmp("\xFB\xFF\xBF", decodeBuffer + testDataLength - 4, 3));
+				Assert::IsTrue(decodedVariant.Alphabet == Base64AlphabetVariant::Base64VariantMixedAlphabets);
+			}
+
+			memcpy(encodeBuffer + encodeLength - 8, savedGroup, 4);
+
+			// Characters outside both alphabets are caught by every kernel, including ones past the ASCII range
+			const char invalidCharacters[] = { '*', '=', '\0', (char)0xAB, (char)0xFF };
+
+			for (char invalidCharacter : invalidCharacters)
+			{
+				char savedCharacter = encodeBuffer[3000];
+				encodeBuffer[3000] = invalidCharacter;
+
+				for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+				{
+					Assert::IsTrue(variantBase64.SetKernel((Base64EncodingKernel)kernel));
+
+					Base64DecodedVariant decodedVariant = { Base64AlphabetVariant::Base64VariantEitherAlphabet, false };
+
+					Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, variantBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength, decodedVariant));
+					Assert::IsTrue(decodedVariant.Alphabet == Base64AlphabetVariant::Base64VariantEitherAlphabet);
+				}
+
+				encodeBuffer[3000] = savedCharacter;
+			}
+
+			delete[] testData;
+			delete[] encodeBuffer;
+			delete[] decodeBuffer;
+		}
+
+		TEST_METHOD(DecodeEitherVariantEdgeCases)
+		{
+			Base64VariantDecoding base64;
+			Base64DecodedVariant variant = {};
+			uint8_t decodeBuffer[16];
+
+			Assert::AreEqual((int64_t)3, base64.Decode("QUJD", 4, decodeBuffer, sizeof(decodeBuffer), variant));
+			Assert::IsTrue(variant.Alphabet == Base64AlphabetVariant::Base64VariantEitherAlphabet);
+			Assert::IsFalse(variant.Padded);
+
+			Assert::AreEqual((int64_t)1, base64.Decode("-w==", 4, decodeBuffer, sizeof(decodeBuffer), variant));
+			Assert::AreEqual((uint8_t)0xFB, decodeBuffer[0]);
+			Assert::IsTrue(variant.Alphabet == Base64AlphabetVariant::Base64VariantUrlSafeAlphabet);
+			Assert::IsTrue(variant.Padded);
+
+			Assert::AreEqual((int64_t)2, base64.Decode("+/8", 3, decodeBuffer, sizeof(decodeBuffer), variant));
+			Assert::IsTrue(variant.Alphabet == Base64AlphabetVariant::Base64VariantStandardAlphabet);
+			Assert::IsFalse(variant.Padded);
+
+			Assert::AreEqual((int64_t)0, base64.Decode("", 0, decodeBuffer, sizeof(decodeBuffer), variant));
+
+			// Padding is only accepted at the end of a whole final group
+			const char* invalidInputs[] = { "YQ=", "Y===", "YQ==YQ==", "YQ*=", "Y=Q=" };
+
+			for (const char* pInput : invalidInputs)
+			{
+				Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, base64.Decode(pInput, strlen(pInput), decodeBuffer, sizeof(decodeBuffer), variant));
+			}
+		}
+
+		TEST_METHOD(EncodeAndDecodeEveryByteValue)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+			char testString[256];
+			int testStringLength = 255;
+			int encodeBufferRequiredLength;
+			char* encodeBuffer;
+			int decodeBufferRequiredLength;
+			char* decodeBuffer;
+
+			for (int i = 0; i < testStringLength; ++i)
+			{
+				testString[i] = (char)(i + 1);
+			}
+
+			testString[testStringLength] = '\0';
+
+			// Encode
+			encodeBufferRequiredLength = base64.EncodedLength(testStringLength) + 1;
+			encodeBuffer = new char[encodeBufferRequiredLength];
+
+			int encodeLength = base64.Encode(testString, encodeBuffer, encodeBufferRequiredLength);
+
+			// Decode
+			decodeBufferRequiredLength = base64.DecodedLength(encodeBuffer, encodeLength) + 1;
+			decodeBuffer = new char[decodeBufferRequiredLength];
+
+			int decodeLength = base64.Decode(encodeBuffer, decodeBuffer, decodeBufferRequiredLength);
+
+			Assert::AreEqual(340, encodeLength);
+			Assert::AreEqual(testStringLength, decodeLength);
+			Assert::AreEqual((const char*)testString, (const char*)decodeBuffer);
+
+			delete[] encodeBuffer;
+			delete[] decodeBuffer;
+		}
+
+		TEST_METHOD(EncodeMatchesScalarForEveryKernel)
+		{
+			char testString[1024];
+			int testStringLength;
+			int encodeBufferRequiredLength;
+			char* scalarEncodeBuffer;
+			char* encodeBuffer;
+			uint32_t seed = 12345;
+
+			for (int i = 0; i < 1023; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testString[i] = (char)(1 + (seed >> 16) % 255);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('-', '_', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (testStringLength = 0; testStringLength < 1023; testStringLength += 7)
+				{
+					char savedCharacter = testString[testStringLength];
+					testString[testStringLength] = '\0';
+
+					encodeBufferRequiredLength = base64.EncodedLength(testStringLength) + 1;
+					scalarEncodeBuffer = new char[encodeBufferRequiredLength];
+					encodeBuffer = new char[encodeBufferRequiredLength];
+
+					base64.SetKernel(Base64EncodingKernel::Base64KernelScalar);
+					base64.Encode(testString, scalarEncodeBuffer, encodeBufferRequiredLength);
+
+					for (int kernel = Base64EncodingKernel::Base64KernelSsse3; kernel <= supportedKernel; ++kernel)
+					{
+						Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+						int encodeLength = base64.Encode(testString, encodeBuffer, encodeBufferRequiredLength);
+
+						Assert::AreEqual(encodeBufferRequiredLength - 1, encodeLength);
+						Assert::AreEqual((const char*)scalarEncodeBuffer, (const char*)encodeBuffer);
+					}
+
+					testString[testStringLength] = savedCharacter;
+
+					delete[] scalarEncodeBuffer;
+					delete[] encodeBuffer;
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(DecodeMatchesEncodedStringForEveryKernel)
+		{
+			char testString[1024];
+			int testStringLength;
+			int encodeBufferRequiredLength;
+			char* encodeBuffer;
+			int decodeBufferRequiredLength;
+			char* decodeBuffer;
+			uint32_t seed = 54321;
+
+			for (int i = 0; i < 1023; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testString[i] = (char)(1 + (seed >> 16) % 255);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('-', '_', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (testStringLength = 1; testStringLength < 1023; testStringLength += 11)
+				{
+					char savedCharacter = testString[testStringLength];
+					testString[testStringLength] = '\0';
+
+					// Encode
+					encodeBufferRequiredLength = base64.EncodedLength(testStringLength) + 1;
+					encodeBuffer = new char[encodeBufferRequiredLength];
+
+					base64.Encode(testString, encodeBuffer, encodeBufferRequiredLength);
+
+					// Decode
+					decodeBufferRequiredLength = base64.DecodedLength(encodeBuffer, encodeBufferRequiredLength - 1) + 1;
+					decodeBuffer = new char[decodeBufferRequiredLength];
+
+					for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+					{
+						Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+						int decodeLength = base64.Decode(encodeBuffer, decodeBuffer, decodeBufferRequiredLength);
+
+						Assert::AreEqual(testStringLength, decodeLength);
+						Assert::AreEqual((const char*)testString, (const char*)decodeBuffer);
+					}
+
+					testString[testStringLength] = savedCharacter;
+
+					delete[] encodeBuffer;
+					delete[] decodeBuffer;
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(DecodeRejectsInvalidCharacterForEveryKernel)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+			char testString[257];
+			int testStringLength = 256;
+			int decodeBufferRequiredLength;
+			char* decodeBuffer;
+
+			for (int i = 0; i < testStringLength; ++i)
+			{
+				testString[i] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i % 64];
+			}
+
+			testString[testStringLength] = '\0';
+
+			decodeBufferRequiredLength = base64.DecodedLength(testString, testStringLength) + 1;
+			decodeBuffer = new char[decodeBufferRequiredLength];
+
+			const char invalidCharacters[] = { '-', '_', '=', ' ', '\x80', '\xff' };
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+				// Padding characters are only valid in the final grouping
+				for (int position = 0; position < testStringLength - 4; position += 5)
+				{
+					for (char invalidCharacter : invalidCharacters)
+					{
+						char savedCharacter = testString[position];
+						testString[position] = invalidCharacter;
+
+						int decodeLength = base64.Decode(testString, decodeBuffer, decodeBufferRequiredLength);
+
+						Assert::AreEqual(BASE64ENCODING_INVALID_CHARACTER, decodeLength);
+
+						testString[position] = savedCharacter;
+					}
+				}
+
+				int decodeLength = base64.Decode(testString, decodeBuffer, decodeBufferRequiredLength);
+
+				Assert::AreEqual(192, decodeLength);
+			}
+
+			delete[] decodeBuffer;
+		}
+
+		TEST_METHOD(EncodeAndDecodeBinaryDataWithNullBytes)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+			uint8_t testData[300];
+			size_t testDataLength = sizeof(testData);
+			size_t encodeBufferRequiredLength;
+			char* encodeBuffer;
+			size_t decodeBufferRequiredLength;
+			uint8_t* decodeBuffer;
+
+			for (size_t i = 0; i < testDataLength; ++i)
+			{
+				testData[i] = (uint8_t)(i * 3);
+			}
+
+			// Encode into a buffer with no room for a null terminator
+			encodeBufferRequiredLength = base64.EncodedLength(testDataLength);
+			encodeBuffer = new char[encodeBufferRequiredLength];
+
+			int encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, encodeBufferRequiredLength);
+
+			Assert::AreEqual(400, encodeLength);
+			Assert::AreEqual(0, strncmp("AAMGCQwPEhUYGx4hJCcqLTAzNjk8P0JFSEtOUVRXWl1gY2Zp", encodeBuffer, 48));
+
+			// Decode into a buffer with no room for a null terminator
+			decodeBufferRequiredLength = base64.DecodedLength(encodeBuffer, encodeLength);
+			decodeBuffer = new uint8_t[decodeBufferRequiredLength];
+
+			int decodeLength = base64.Decode(encodeBuffer, encodeLength, decodeBuffer, decodeBufferRequiredLength);
+
+			Assert::AreEqual(300, decodeLength);
+			Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+
+			// Buffers one byte too small are rejected
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, base64.Encode(testData, testDataLength, encodeBuffer, encodeBufferRequiredLength - 1));
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, base64.Decode(encodeBuffer, encodeLength, decodeBuffer, decodeBufferRequiredLength - 1));
+
+			delete[] encodeBuffer;
+			delete[] decodeBuffer;
+		}
+
+		TEST_METHOD(DecodeStopsAtGivenLength)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Unpadded);
+
+			const char* testString = "YWJjZA trailing data that is not Base64";
+			uint8_t decodeBuffer[4];
+
+			int decodeLength = base64.Decode(testString, 6, decodeBuffer, sizeof(decodeBuffer));
+
+			Assert::AreEqual(4, decodeLength);
+			Assert::AreEqual(0, memcmp("abcd", decodeBuffer, 4));
+		}
+
+		TEST_METHOD(LengthsBeyond4GB)
+		{
+			Base64Encoding paddedBase64('+', '/', Base64EncodingOptions::Padded);
+			Base64Encoding unpaddedBase64('+', '/', Base64EncodingOptions::Unpadded);
+
+#if SIZE_MAX > UINT32_MAX
+			size_t inputLength = (size_t)5 * 1024 * 1024 * 1024;
+
+			Assert::AreEqual((size_t)7158278828, paddedBase64.EncodedLength(inputLength));
+			Assert::AreEqual((size_t)7158278827, unpaddedBase64.EncodedLength(inputLength));
+			// Unpadded lengths do not depend on the characters, so none are passed
+			Assert::AreEqual((size_t)5368709120, unpaddedBase64.DecodedLength(NULL, 7158278827));
+#endif
+
+			// Encoded lengths that cannot be represented are reported rather than wrapped
+			Assert::AreEqual((size_t)BASE64ENCODING_LENGTH_OVERFLOW, paddedBase64.EncodedLength(SIZE_MAX));
+			Assert::AreEqual((size_t)BASE64ENCODING_LENGTH_OVERFLOW, unpaddedBase64.EncodedLength(SIZE_MAX - 1));
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, paddedBase64.Encode((const uint8_t*)"", SIZE_MAX, NULL, SIZE_MAX));
+		}
+
+		TEST_METHOD(LengthFormulasMatchEncodedData)
+		{
+			static_assert(Base64StandardCodec::EncodedLength(5) == 8, "Padded encoded length");
+			static_assert(Base64StandardUnpaddedCodec::EncodedLength(5) == 7, "Unpadded encoded length");
+			static_assert(Base64StandardCodec::DecodedLength("YWJjZA==", 8) == 4, "Padded decoded length");
+			static_assert(Base64StandardCodec::DecodedLength("==", 2) == 0, "Padding without a set of four");
+			static_assert(Base64StandardUnpaddedCodec::DecodedLength("YWJjZA", 6) == 4, "Unpadded decoded length");
+
+			uint8_t testData[40] = {};
+			char encodeBuffer[64];
+
+			for (size_t testDataLength = 0; testDataLength <= sizeof(testData); ++testDataLength)
+			{
+				Assert::AreEqual(((testDataLength + 2) / 3) * 4, Base64StandardCodec::EncodedLength(testDataLength));
+				Assert::AreEqual((testDataLength * 4 + 2) / 3, Base64StandardUnpaddedCodec::EncodedLength(testDataLength));
+
+				int64_t encodeLength = Base64StandardCodec::Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+				Assert::AreEqual(testDataLength, Base64StandardCodec::DecodedLength(encodeBuffer, (size_t)encodeLength));
+
+				encodeLength = Base64StandardUnpaddedCodec::Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+				Assert::AreEqual(testDataLength, Base64StandardUnpaddedCodec::DecodedLength(encodeBuffer, (size_t)encodeLength));
+			}
+		}
+
+		TEST_METHOD(TryEncodeAndTryDecodeReportRequiredLength)
+		{
+			uint8_t testData[300];
+			char encodeBuffer[400];
+			uint8_t decodeBuffer[300];
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				testData[i] = (uint8_t)(i * 13 + 5);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 7)
+				{
+					// Measuring writes nothing, not even through a null buffer
+					int64_t encodeLength = base64.TryEncode(testData, testDataLength, NULL, 0);
+
+					Assert::AreEqual((int64_t)base64.EncodedLength(testDataLength), encodeLength);
+
+					memset(encodeBuffer, '*', sizeof(encodeBuffer));
+
+					if (encodeLength > 0)
+					{
+						Assert::AreEqual(encodeLength, base64.TryEncode(testData, testDataLength, encodeBuffer, (size_t)encodeLength - 1));
+						Assert::AreEqual('*', encodeBuffer[0]);
+					}
+
+					Assert::AreEqual(encodeLength, base64.TryEncode(testData, testDataLength, encodeBuffer, (size_t)encodeLength));
+					Assert::AreEqual('*', encodeBuffer[encodeLength]);
+
+					int64_t decodeLength = base64.TryDecode(encodeBuffer, (size_t)encodeLength, NULL, 0);
+
+					Assert::AreEqual((int64_t)testDataLength, decodeLength);
+					Assert::AreEqual(decodeLength, base64.TryDecode(encodeBuffer, (size_t)encodeLength, decodeBuffer, (size_t)decodeLength));
+					Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+				}
+			}
+
+			// Invalid characters are found once the data fits
+			Assert::AreEqual((int64_t)3, Base64StandardCodec::TryDecode("YW*j", 4, decodeBuffer, 2));
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::TryDecode("YW*j", 4, decodeBuffer, 3));
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, Base64StandardCodec::TryEncode((const uint8_t*)"", SIZE_MAX, NULL, 0));
+		}
+
+#if !defined(_WIN32) && SIZE_MAX > UINT32_MAX
+
+		TEST_METHOD(EncodeAndDecodeBeyond4GB)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+			// Just over 4 GB of zero bytes encodes to a string of 'A' characters
+			size_t testDataLength = ((size_t)1 << 32) + 2;
+			size_t encodedLength = base64.EncodedLength(testDataLength);
+
+			uint8_t* testData = MapRepeatedBlock(testDataLength, 0);
+			uint8_t* encodeBuffer = MapRepeatedBlock(encodedLength, 0xFF);
+
+			Assert::IsTrue(testData != NULL && encodeBuffer != NULL);
+
+			int64_t encodeLength = base64.Encode(testData, testDataLength, (char*)encodeBuffer, encodedLength);
+
+			Assert::AreEqual((int64_t)5726623064, encodeLength);
+			Assert::AreEqual((uint8_t)'A', encodeBuffer[0]);
+			Assert::AreEqual((uint8_t)'A', encodeBuffer[RepeatedBlockLength - 1]);
+
+			// Decode the 'A' characters back over the zeroed data
+			memset(testData, 0xFF, RepeatedBlockLength);
+
+			int64_t decodeLength = base64.Decode((const char*)encodeBuffer, encodedLength, testData, testDataLength);
+
+			Assert::AreEqual((int64_t)testDataLength, decodeLength);
+			Assert::AreEqual((uint8_t)0, testData[0]);
+			Assert::AreEqual((uint8_t)0, testData[RepeatedBlockLength - 1]);
+
+			UnmapRepeatedBlock(testData, testDataLength);
+			UnmapRepeatedBlock(encodeBuffer, encodedLength);
+		}
+
+#endif
+
+		TEST_METHOD(StreamEncodeAndDecodeInChunks)
+		{
+			uint8_t testData[1000];
+			size_t testDataLength = sizeof(testData);
+			char encodeBuffer[1400];
+			char streamEncodeBuffer[1400];
+			uint8_t streamDecodeBuffer[1000];
+			uint32_t seed = 777;
+
+			for (size_t i = 0; i < testDataLength; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+			size_t chunkLengths[] = { 1, 2, 4, 5, 7, 64, 333 };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64StreamEncoder encoder(base64);
+				Base64StreamDecoder decoder(base64);
+
+				int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+				for (size_t chunkLength : chunkLengths)
+				{
+					// Encode
+					int64_t streamEncodeLength = 0;
+
+					for (size_t offset = 0; offset < testDataLength; offset += chunkLength)
+					{
+						size_t length = offset + chunkLength < testDataLength ? chunkLength : testDataLength - offset;
+						int64_t written = encoder.Update(testData + offset, length, streamEncodeBuffer + streamEncodeLength, encoder.UpdateLength(length));
+
+						Assert::IsTrue(written >= 0);
+						streamEncodeLength += written;
+					}
+
+					streamEncodeLength += encoder.Finish(streamEncodeBuffer + streamEncodeLength, encoder.FinishLength());
+
+					Assert::AreEqual(encodeLength, streamEncodeLength);
+					Assert::AreEqual(0, memcmp(encodeBuffer, streamEncodeBuffer, (size_t)encodeLength));
+
+					// Decode
+					int64_t streamDecodeLength = 0;
+
+					for (int64_t offset = 0; offset < encodeLength; offset += chunkLength)
+					{
+						size_t length = offset + (int64_t)chunkLength < encodeLength ? chunkLength : (size_t)(encodeLength - offset);
+						int64_t written = decoder.Update(encodeBuffer + offset, length, streamDecodeBuffer + streamDecodeLength, decoder.UpdateLength(length));
+
+						Assert::IsTrue(written >= 0);
+						streamDecodeLength += written;
+					}
+
+					streamDecodeLength += decoder.Finish(streamDecodeBuffer + streamDecodeLength, decoder.FinishLength());
+
+					Assert::AreEqual((int64_t)testDataLength, streamDecodeLength);
+					Assert::AreEqual(0, memcmp(testData, streamDecodeBuffer, testDataLength));
+				}
+			}
+		}
+
+		TEST_METHOD(StreamDecodeRejectsDataAfterPadding)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64StreamDecoder decoder(base64);
+
+			uint8_t decodeBuffer[16];
+
+			// Padding split across chunks
+			Assert::AreEqual((int64_t)0, decoder.Update("YQ", 2, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((int64_t)1, decoder.Update("==", 2, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((uint8_t)'a', decodeBuffer[0]);
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, decoder.Update("YWJj", 4, decodeBuffer, sizeof(decodeBuffer)));
+
+			decoder.Reset();
+
+			Assert::AreEqual((int64_t)3, decoder.Update("YWJj", 4, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((int64_t)0, decoder.Finish(decodeBuffer, sizeof(decodeBuffer)));
+		}
+
+		TEST_METHOD(StreamDecodeRejectsTruncatedPaddedStream)
+		{
+			Base64Encoding paddedBase64('+', '/', Base64EncodingOptions::Padded);
+			Base64Encoding unpaddedBase64('+', '/', Base64EncodingOptions::Unpadded);
+			Base64StreamDecoder paddedDecoder(paddedBase64);
+			Base64StreamDecoder unpaddedDecoder(unpaddedBase64);
+
+			uint8_t decodeBuffer[16];
+
+			// "YWJjZA==" cut short after two or three characters of its final set loses bytes, so Finish reports it
+			Assert::AreEqual((int64_t)3, paddedDecoder.Update("YWJjZA", 6, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, paddedDecoder.Finish(decodeBuffer, sizeof(decodeBuffer)));
+
+			paddedDecoder.Reset();
+
+			Assert::AreEqual((int64_t)3, paddedDecoder.Update("YWJjZA=", 7, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, paddedDecoder.Finish(decodeBuffer, sizeof(decodeBuffer)));
+
+			// Without padding the same tail is the final set
+			Assert::AreEqual((int64_t)3, unpaddedDecoder.Update("YWJjZA", 6, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((int64_t)1, unpaddedDecoder.Finish(decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((uint8_t)'d', decodeBuffer[0]);
+		}
+
+		TEST_METHOD(ParallelEncodeAndDecodeMatchSerial)
+		{
+			uint8_t testData[10000];
+			char encodeBuffer[13400];
+			char parallelEncodeBuffer[13400];
+			uint8_t parallelDecodeBuffer[10000];
+			uint32_t seed = 4242;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			Base64ThreadPool threadPool(3);
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+			size_t testDataLengths[] = { 0, 1, 2, 3, 100, 9998, 9999, 10000 };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64ParallelEncoding parallelBase64(base64, threadPool);
+
+				// Split even small inputs across every thread
+				parallelBase64.SetMinimumChunkLength(16);
+
+				for (size_t testDataLength : testDataLengths)
+				{
+					int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+					int64_t parallelEncodeLength = parallelBase64.Encode(testData, testDataLength, parallelEncodeBuffer, sizeof(parallelEncodeBuffer));
+
+					Assert::AreEqual(encodeLength, parallelEncodeLength);
+					Assert::AreEqual(0, memcmp(encodeBuffer, parallelEncodeBuffer, (size_t)encodeLength));
+
+					int64_t parallelDecodeLength = parallelBase64.Decode(parallelEncodeBuffer, (size_t)parallelEncodeLength, parallelDecodeBuffer, sizeof(parallelDecodeBuffer));
+
+					Assert::AreEqual((int64_t)testDataLength, parallelDecodeLength);
+					Assert::AreEqual(0, memcmp(testData, parallelDecodeBuffer, testDataLength));
+				}
+
+				// An invalid character in any chunk fails the whole decode
+				int64_t encodeLength = parallelBase64.Encode(testData, sizeof(testData), parallelEncodeBuffer, sizeof(parallelEncodeBuffer));
+				parallelEncodeBuffer[encodeLength / 2] = '*';
+
+				Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, parallelBase64.Decode(parallelEncodeBuffer, (size_t)encodeLength, parallelDecodeBuffer, sizeof(parallelDecodeBuffer)));
+			}
+		}
+
+		TEST_METHOD(CodecMatchesRuntimeEncoding)
+		{
+			Base64Encoding standard('+', '/', Base64EncodingOptions::Padded);
+			Base64Encoding standardUnpadded('+', '/', Base64EncodingOptions::Unpadded);
+			Base64Encoding urlSafe('-', '_', Base64EncodingOptions::Padded);
+			Base64Encoding urlSafeUnpadded('-', '_', Base64EncodingOptions::Unpadded);
+
+			AssertCodecMatchesEncoding<Base64StandardCodec>(standard);
+			AssertCodecMatchesEncoding<Base64StandardUnpaddedCodec>(standardUnpadded);
+			AssertCodecMatchesEncoding<Base64UrlSafeCodec>(urlSafe);
+			AssertCodecMatchesEncoding<Base64UrlSafeUnpaddedCodec>(urlSafeUnpadded);
+		}
+
+		TEST_METHOD(CodecTablesAreBuiltAtCompileTime)
+		{
+			static_assert(Base64StandardCodec::Alphabet.EncodeTable[62] == '+', "62nd character");
+			static_assert(Base64UrlSafeCodec::Alphabet.EncodeTable[63] == '_', "63rd character");
+			static_assert(Base64UrlSafeCodec::Alphabet.DecodeTable['/'] == BASE64ENCODING_INVALID_SEXTET, "Character outside the alphabet");
+			static_assert(Base64StandardCodec::EncodedLength(4) == 8, "Padded length");
+			static_assert(Base64StandardUnpaddedCodec::EncodedLength(4) == 6, "Unpadded length");
+
+			char* testString = "\xfb\xff\xbf";
+			char encodeBuffer[5];
+			char decodeBuffer[4];
+
+			Assert::AreEqual((int64_t)4, Base64UrlSafeUnpaddedCodec::Encode(testString, encodeBuffer, sizeof(encodeBuffer)));
+			Assert::AreEqual("-_-_", (const char*)encodeBuffer);
+			Assert::AreEqual((int64_t)3, Base64UrlSafeUnpaddedCodec::Decode(encodeBuffer, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual((const char*)testString, (const char*)decodeBuffer);
+
+			// The standard alphabet rejects the URL-safe characters
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardUnpaddedCodec::Decode(encodeBuffer, decodeBuffer, sizeof(decodeBuffer)));
+		}
+
+		TEST_METHOD(EncodeAndDecodeAtCompileTime)
+		{
+			static_assert(ConstantEquals(Base64StandardUnpaddedCodec::EncodeConstant("a"), "YQ"), "Encode 1 character without padding");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant("a"), "YQ=="), "Encode 1 character with padding");
+			static_assert(ConstantEquals(Base64StandardUnpaddedCodec::EncodeConstant("ab"), "YWI"), "Encode 2 characters without padding");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant("ab"), "YWI="), "Encode 2 characters with padding");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant("abc"), "YWJj"), "Encode 3 characters");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant("abcd"), "YWJjZA=="), "Encode 4 characters with padding");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant("The Quick Brown Fox Jumps Over The Lazy Dog."), "VGhlIFF1aWNrIEJyb3duIEZveCBKdW1wcyBPdmVyIFRoZSBMYXp5IERvZy4="), "Encode sentence with padding");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant("\xff\xfe"), "//4="), "Encode high bytes with padding");
+			static_assert(ConstantEquals(Base64UrlSafeUnpaddedCodec::EncodeConstant("\xfb\xff\xbf"), "-_-_"), "Encode custom characters");
+			static_assert(ConstantEquals(Base64StandardCodec::EncodeConstant(std::array<uint8_t, 3>{ 0x00, 0x10, 0x83 }), "ABCD"), "Encode binary data");
+
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardUnpaddedCodec, "YQ"), "a"), "Decode 1 character without padding");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardCodec, "YQ=="), "a"), "Decode 1 character with padding");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardUnpaddedCodec, "YWI"), "ab"), "Decode 2 characters without padding");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardCodec, "YWI="), "ab"), "Decode 2 characters with padding");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardCodec, "YWJj"), "abc"), "Decode 3 characters");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardUnpaddedCodec, "YWJjZA"), "abcd"), "Decode 4 characters without padding");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64StandardCodec, "YWJjZA=="), "abcd"), "Decode 4 characters with padding");
+			static_assert(ConstantEquals(BASE64ENCODING_DECODE_CONSTANT(Base64UrlSafeUnpaddedCodec, "-_-_"), "\xfb\xff\xbf"), "Decode custom characters");
+
+			// Constants can be kept in read-only data and match the runtime decode
+			static constexpr std::array<uint8_t, 44> decoded = BASE64ENCODING_DECODE_CONSTANT(Base64StandardCodec, "VGhlIFF1aWNrIEJyb3duIEZveCBKdW1wcyBPdmVyIFRoZSBMYXp5IERvZy4=");
+
+			Assert::AreEqual(0, memcmp("The Quick Brown Fox Jumps Over The Lazy Dog.", decoded.data(), decoded.size()));
+		}
+
+		TEST_METHOD(DecodeInPlaceForEveryKernel)
+		{
+			uint8_t testData[1000];
+			char encodeBuffer[1400];
+			char inPlaceBuffer[1400];
+			uint32_t seed = 2468;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 13)
+				{
+					int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+					for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+					{
+						Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+						memcpy(inPlaceBuffer, encodeBuffer, (size_t)encodeLength);
+
+						int64_t decodeLength = base64.DecodeInPlace(inPlaceBuffer, (size_t)encodeLength);
+
+						Assert::AreEqual((int64_t)testDataLength, decodeLength);
+						Assert::AreEqual(0, memcmp(testData, inPlaceBuffer, testDataLength));
+					}
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(DecodeStringInPlace)
+		{
+			char testString[] = "VGhlIFF1aWNrIEJyb3duIEZveCBKdW1wcyBPdmVyIFRoZSBMYXp5IERvZy4=";
+
+			Assert::AreEqual((int64_t)44, Base64StandardCodec::DecodeInPlace(testString));
+			Assert::AreEqual("The Quick Brown Fox Jumps Over The Lazy Dog.", (const char*)testString);
+
+			// A character outside the alphabet is still reported
+			char invalidString[] = "YW*jZA==";
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::DecodeInPlace(invalidString));
+		}
+
+		TEST_METHOD(EncodeInPlaceForEveryKernel)
+		{
+			uint8_t testData[1000];
+			char encodeBuffer[1400];
+			char inPlaceBuffer[1400];
+			uint32_t seed = 1357;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 7)
+				{
+					int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+					for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+					{
+						Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+						// The buffer is sized exactly to the encoded length
+						memcpy(inPlaceBuffer, testData, testDataLength);
+
+						Assert::AreEqual(encodeLength, base64.EncodeInPlace(inPlaceBuffer, testDataLength, (size_t)encodeLength));
+						Assert::AreEqual(0, memcmp(encodeBuffer, inPlaceBuffer, (size_t)encodeLength));
+					}
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+
+			// A buffer too small for the encoded string is rejected
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, Base64StandardCodec::EncodeInPlace(inPlaceBuffer, 4, 7));
+		}
+
+		TEST_METHOD(DecodeStrictAcceptsCanonicalInput)
+		{
+			uint8_t decodeBuffer[64];
+			Base64DecodeResult result;
+
+			result = Base64StandardCodec::DecodeStrict("YWJjZA==", 8, decodeBuffer, sizeof(decodeBuffer));
+
+			Assert::IsTrue(result.Status == Base64DecodeStatus::Base64DecodeSucceeded);
+			Assert::AreEqual((size_t)4, result.BytesWritten);
+			Assert::AreEqual(0, memcmp("abcd", decodeBuffer, 4));
+
+			result = Base64StandardUnpaddedCodec::DecodeStrict("YWI", 3, decodeBuffer, sizeof(decodeBuffer));
+
+			Assert::IsTrue(result.Status == Base64DecodeStatus::Base64DecodeSucceeded);
+			Assert::AreEqual((size_t)2, result.BytesWritten);
+			Assert::AreEqual(0, memcmp("ab", decodeBuffer, 2));
+
+			result = Base64StandardCodec::DecodeStrict("", 0, decodeBuffer, sizeof(decodeBuffer));
+
+			Assert::IsTrue(result.Status == Base64DecodeStatus::Base64DecodeSucceeded);
+			Assert::AreEqual((size_t)0, result.BytesWritten);
+
+			result = Base64StandardCodec::DecodeStrict("YWJj", 4, decodeBuffer, 2);
+
+			Assert::IsTrue(result.Status == Base64DecodeStatus::Base64DecodeOutputBufferOverflow);
+		}
+
+		TEST_METHOD(DecodeStrictRejectsMalformedInput)
+		{
+			struct
+			{
+				bool Padded;
+				const char* Input;
+				Base64DecodeStatus Status;
+				size_t ErrorOffset;
+			}
+			testCases[] =
+			{
+				{ true, "YWJjZA=", Base64DecodeStatus::Base64DecodeInvalidLength, 4 },
+				{ true, "YWJjZA===", Base64DecodeStatus::Base64DecodeInvalidLength, 8 },
+				{ false, "YWJjZ", Base64DecodeStatus::Base64DecodeInvalidLength, 4 },
+				{ true, "YW=j", Base64DecodeStatus::Base64DecodeInvalidPadding, 2 },
+				{ true, "Y===", Base64DecodeStatus::Base64DecodeInvalidPadding, 1 },
+				{ true, "====", Base64DecodeStatus::Base64DecodeInvalidPadding, 0 },
+				{ true, "YQ==YWJj", Base64DecodeStatus::Base64DecodeInvalidPadding, 2 },
+				{ false, "YQ==", Base64DecodeStatus::Base64DecodeInvalidPadding, 2 },
+				{ true, "YW*j", Base64DecodeStatus::Base64DecodeInvalidCharacter, 2 },
+				{ true, "YR==", Base64DecodeStatus::Base64DecodeNonCanonicalTrailingBits, 1 },
+				{ true, "YWJ=", Base64DecodeStatus::Base64DecodeNonCanonicalTrailingBits, 2 },
+				{ false, "YWJjZB", Base64DecodeStatus::Base64DecodeNonCanonicalTrailingBits, 5 },
+			};
+
+			uint8_t decodeBuffer[16];
+
+			for (auto& testCase : testCases)
+			{
+				Base64Encoding base64('+', '/', testCase.Padded ? Base64EncodingOptions::Padded : Base64EncodingOptions::Unpadded);
+				Base64DecodeResult result = base64.DecodeStrict(testCase.Input, strlen(testCase.Input), decodeBuffer, sizeof(decodeBuffer));
+
+				Assert::IsTrue(result.Status == testCase.Status);
+				Assert::AreEqual(testCase.ErrorOffset, result.ErrorOffset);
+			}
+		}
+
+		TEST_METHOD(DecodeStrictReportsErrorOffsetForEveryKernel)
+		{
+			uint8_t testData[600];
+			char encodeBuffer[800];
+			uint8_t decodeBuffer[600];
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				testData[i] = (uint8_t)(i * 13);
+			}
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64EncodingKernel supportedKernel = base64.GetKernel();
+			int64_t encodeLength = base64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer));
+			size_t errorOffsets[] = { 0, 5, 100, 511, 799 };
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+				Base64DecodeResult result = base64.DecodeStrict(encodeBuffer, (size_t)encodeLength, decodeBuffer, sizeof(decodeBuffer));
+
+				Assert::IsTrue(result.Status == Base64DecodeStatus::Base64DecodeSucceeded);
+				Assert::AreEqual(sizeof(testData), result.BytesWritten);
+				Assert::AreEqual(0, memcmp(testData, decodeBuffer, sizeof(testData)));
+
+				for (size_t errorOffset : errorOffsets)
+				{
+					char savedCharacter = encodeBuffer[errorOffset];
+					encodeBuffer[errorOffset] = '\n';
+
+					result = base64.DecodeStrict(encodeBuffer, (size_t)encodeLength, decodeBuffer, sizeof(decodeBuffer));
+
+					Assert::IsTrue(result.Status == Base64DecodeStatus::Base64DecodeInvalidCharacter);
+					Assert::AreEqual(errorOffset, result.ErrorOffset);
+					Assert::AreEqual((errorOffset / 4) * 3, result.BytesWritten);
+
+					encodeBuffer[errorOffset] = savedCharacter;
+				}
+			}
+
+			base64.SetKernel(supportedKernel);
+		}
+
+		TEST_METHOD(EncodeLinesForEveryKernel)
+		{
+			uint8_t testData[2000];
+			char encodeBuffer[2700];
+			char wrappedBuffer[4000];
+			uint32_t seed = 24680;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			struct
+			{
+				size_t LineLength;
+				Base64LineBreak LineBreak;
+				const char* LineBreakCharacters;
+			}
+			layouts[] = { { 76, Base64LineBreak::Base64LineBreakCrlf, "\r\n" }, { 64, Base64LineBreak::Base64LineBreakLf, "\n" }, { 64, Base64LineBreak::Base64LineBreakCrlf, "\r\n" }, { 128, Base64LineBreak::Base64LineBreakLf, "\n" },
+			              { 4, Base64LineBreak::Base64LineBreakLf, "\n" }, { 30, Base64LineBreak::Base64LineBreakCrlf, "\r\n" }, { 7, Base64LineBreak::Base64LineBreakLf, "\n" } };
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 37)
+				{
+					int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+					for (auto& layout : layouts)
+					{
+						// The expected output has no line break after the final line
+						size_t wrappedLength = WrapLines(encodeBuffer, (size_t)encodeLength, layout.LineLength, layout.LineBreakCharacters, wrappedBuffer);
+
+						if(wrappedLength > 0)
+						{
+							wrappedLength -= strlen(layout.LineBreakCharacters);
+						}
+
+						Assert::AreEqual(wrappedLength, base64.EncodedLength(testDataLength, layout.LineLength, layout.LineBreak));
+
+						for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+						{
+							Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+							// The output buffer is sized exactly, so any store beyond the encoded string would be caught
+							char* lineBuffer = new char[wrappedLength + 1];
+
+							int64_t lineLength = base64.Encode(testData, testDataLength, lineBuffer, wrappedLength, layout.LineLength, layout.LineBreak);
+
+							Assert::AreEqual((int64_t)wrappedLength, lineLength);
+							Assert::AreEqual(0, memcmp(wrappedBuffer, lineBuffer, wrappedLength));
+
+							delete[] lineBuffer;
+						}
+					}
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(EncodeLinesLengths)
+		{
+			uint8_t testData[114] = { 0 };
+			char outputBuffer[200];
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+			// 57 bytes fill exactly one 76 character MIME line, so a second line only starts with the 58th byte
+			Assert::AreEqual((size_t)0, base64.EncodedLength(0, 76, Base64LineBreak::Base64LineBreakCrlf));
+			Assert::AreEqual((size_t)76, base64.EncodedLength(57, 76, Base64LineBreak::Base64LineBreakCrlf));
+			Assert::AreEqual((size_t)82, base64.EncodedLength(58, 76, Base64LineBreak::Base64LineBreakCrlf));
+			Assert::AreEqual((size_t)153, base64.EncodedLength(114, 76, Base64LineBreak::Base64LineBreakLf));
+			Assert::AreEqual((size_t)152, base64.EncodedLength(114, 0, Base64LineBreak::Base64LineBreakLf));
+			Assert::AreEqual((size_t)BASE64ENCODING_LENGTH_OVERFLOW, base64.EncodedLength(SIZE_MAX / 4 * 3 - 3, 4, Base64LineBreak::Base64LineBreakCrlf));
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, base64.Encode(testData, sizeof(testData), outputBuffer, 153, 76, Base64LineBreak::Base64LineBreakCrlf));
+			Assert::AreEqual((int64_t)154, base64.Encode(testData, sizeof(testData), outputBuffer, 154, 76, Base64LineBreak::Base64LineBreakCrlf));
+			Assert::AreEqual(0, memcmp(outputBuffer + 76, "\r\n", 2));
+
+			Assert::AreEqual(Base64StandardCodec::EncodedLength(sizeof(testData), 64, Base64LineBreak::Base64LineBreakLf), (size_t)Base64StandardCodec::Encode(testData, sizeof(testData), outputBuffer, sizeof(outputBuffer), 64, Base64LineBreak::Base64LineBreakLf));
+			Assert::AreEqual('\n', outputBuffer[64]);
+		}
+
+		TEST_METHOD(EncodeAndDecodeBatchForEveryKernel)
+		{
+			uint8_t testData[8000];
+			char encodeBuffer[2000];
+			uint32_t seed = 13579;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			// Short items of every length modulo three are gathered into blocks, while the longest are encoded and decoded straight from the input
+			Base64BatchItem items[120];
+			size_t itemCount = sizeof(items) / sizeof(items[0]);
+			size_t position = 0;
+
+			for (size_t i = 0; i < itemCount; ++i)
+			{
+				size_t length = i % 40 == 39 ? 1000 + i : (i * 7) % 53;
+
+				items[i] = { testData + position, length };
+				position += length;
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+				size_t encodedLength = base64.EncodedBatchLength(items, itemCount);
+
+				for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+				{
+					Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+					// The output buffers are sized exactly, so any store beyond the batch would be caught
+					char* encodedBatch = new char[encodedLength];
+					size_t offsets[121];
+
+					Assert::AreEqual((int64_t)encodedLength, base64.EncodeBatch(items, itemCount, encodedBatch, encodedLength, offsets));
+					Assert::AreEqual((size_t)0, offsets[0]);
+					Assert::AreEqual(encodedLength, offsets[itemCount]);
+
+					Base64BatchItem encodedItems[120];
+
+					for (size_t i = 0; i < itemCount; ++i)
+					{
+						int64_t encodeLength = base64.Encode((const uint8_t*)items[i].pData, items[i].Length, encodeBuffer, sizeof(encodeBuffer));
+
+						Assert::AreEqual((size_t)encodeLength, offsets[i + 1] - offsets[i]);
+						Assert::AreEqual(0, memcmp(encodeBuffer, encodedBatch + offsets[i], offsets[i + 1] - offsets[i]));
+
+						encodedItems[i] = { encodedBatch + offsets[i], (size_t)encodeLength };
+					}
+
+					size_t decodedLength = base64.DecodedBatchLength(encodedItems, itemCount);
+					uint8_t* decodedBatch = new uint8_t[decodedLength];
+
+					Assert::AreEqual(position, decodedLength);
+					Assert::AreEqual((int64_t)decodedLength, base64.DecodeBatch(encodedItems, itemCount, decodedBatch, decodedLength, offsets));
+					Assert::AreEqual(0, memcmp(testData, decodedBatch, decodedLength));
+
+					for (size_t i = 0; i < itemCount; ++i)
+					{
+						Assert::AreEqual(items[i].Length, offsets[i + 1] - offsets[i]);
+					}
+
+					delete[] decodedBatch;
+					delete[] encodedBatch;
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(EncodeAndDecodeBatchErrors)
+		{
+			uint8_t testData[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+			char outputBuffer[64];
+			uint8_t decodeBuffer[64];
+			size_t offsets[4];
+
+			Base64BatchItem items[] = { { testData, 3 }, { testData + 3, 7 }, { testData, 1 } };
+			Base64BatchItem encodedItems[] = { { "AQID", 4 }, { "BAUGBwgJCg==", 12 }, { "A*==", 4 } };
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+			Assert::AreEqual((size_t)20, base64.EncodedBatchLength(items, 3));
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+				Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, base64.EncodeBatch(items, 3, outputBuffer, 19, offsets));
+				Assert::AreEqual((int64_t)20, base64.EncodeBatch(items, 3, outputBuffer, sizeof(outputBuffer), offsets));
+				Assert::AreEqual(0, memcmp(outputBuffer, "AQIDBAUGBwgJCg==AQ==", 20));
+
+				Assert::AreEqual((int64_t)10, base64.DecodeBatch(encodedItems, 2, decodeBuffer, sizeof(decodeBuffer), offsets));
+				Assert::AreEqual(0, memcmp(testData, decodeBuffer, 10));
+				Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, base64.DecodeBatch(encodedItems, 2, decodeBuffer, 9, offsets));
+				Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, base64.DecodeBatch(encodedItems, 3, decodeBuffer, sizeof(decodeBuffer), offsets));
+			}
+
+			base64.SetKernel(supportedKernel);
+		}
+
+		TEST_METHOD(EncodeAndDecodeToSinks)
+		{
+			uint8_t testData[300];
+			char encodeBuffer[400];
+
+			for (size_t i = 0; i < sizeof(testData); i++)
+			{
+				testData[i] = (uint8_t)(i * 37 + 11);
+			}
+
+			for (int padded = 0; padded <= 1; padded++)
+			{
+				Base64Encoding base64('+', '/', padded ? Base64EncodingOptions::Padded : Base64EncodingOptions::Unpadded);
+				Base64SinkEncoding sinkBase64(base64);
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += testDataLength < 16 ? 1 : 71)
+				{
+					int64_t encodedLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+					std::string_view encoded(encodeBuffer, (size_t)encodedLength);
+					std::string_view data((const char*)testData, testDataLength);
+
+					// The string sink appends to what the string already holds
+					std::string encodedString = "prefix";
+					Assert::AreEqual(encodedLength, sinkBase64.Encode(data, Base64StringSink(encodedString)));
+					Assert::IsTrue(encodedString == "prefix" + std::string(encoded));
+
+					std::string decodedString;
+					Assert::AreEqual((int64_t)testDataLength, sinkBase64.Decode(encoded, Base64StringSink(decodedString)));
+					Assert::IsTrue(decodedString == data);
+
+					// Output handed to a callback arrives in whole blocks
+					std::string appended;
+					Base64CallbackSink appender([&](const char* pData, size_t length) { appended.append(pData, length); });
+					Assert::AreEqual(encodedLength, sinkBase64.Encode(testData, testDataLength, appender));
+					Assert::IsTrue(appended == encoded);
+
+					char buffer[400];
+					Base64BufferSink bufferSink(buffer, (size_t)encodedLength);
+					Assert::AreEqual(encodedLength, sinkBase64.Encode(data, bufferSink));
+					Assert::AreEqual((size_t)encodedLength, bufferSink.Length());
+					Assert::AreEqual(0, memcmp(encodeBuffer, buffer, (size_t)encodedLength));
+
+					if (encodedLength > 0)
+					{
+						Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, sinkBase64.Encode(data, Base64BufferSink(buffer, (size_t)encodedLength - 1)));
+						Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, sinkBase64.Decode(encoded, Base64BufferSink(buffer, testDataLength - 1)));
+					}
+				}
+			}
+		}
+
+#ifdef __cpp_lib_span
+
+		TEST_METHOD(EncodeAndDecodeSpans)
+		{
+			uint8_t testData[100];
+			char encodeBuffer[200];
+
+			for (size_t i = 0; i < sizeof(testData); i++)
+			{
+				testData[i] = (uint8_t)(i * 53 + 7);
+			}
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64SinkEncoding sinkBase64(base64);
+
+			for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 11)
+			{
+				int64_t encodedLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+				char encoded[200];
+				std::span<const std::byte> data(reinterpret_cast<const std::byte*>(testData), testDataLength);
+				Base64BufferSink encodeSink(std::span<char>(encoded, (size_t)encodedLength));
+
+				Assert::AreEqual(encodedLength, sinkBase64.Encode(data, encodeSink));
+				Assert::AreEqual(0, memcmp(encodeBuffer, encoded, (size_t)encodedLength));
+
+				std::byte decoded[100];
+				Base64BufferSink decodeSink(std::span<std::byte>(decoded, testDataLength));
+
+				Assert::AreEqual((int64_t)testDataLength, sinkBase64.Decode(std::string_view(encoded, (size_t)encodedLength), decodeSink));
+				Assert::AreEqual(0, memcmp(testData, decoded, testDataLength));
+			}
+		}
+
+#endif
+
+		TEST_METHOD(DecodeToSinksRejectsInvalidInput)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64SinkEncoding sinkBase64(base64);
+			std::string decoded;
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, sinkBase64.Decode("YWJj*mNk", Base64StringSink(decoded)));
+
+			char buffer[16];
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, sinkBase64.Decode("YQ==YWJjYWJj", Base64BufferSink(buffer, sizeof(buffer))));
+
+			// Padding that ends the first block a callback sink is handed is still in the middle of the string
+			std::string testString = std::string(BASE64ENCODING_SINK_BLOCK_LENGTH / 3 * 4 - 4, 'A') + "YQ==" + std::string(400, 'A');
+			std::string appended;
+			Base64CallbackSink appender([&](const char* pData, size_t length) { appended.append(pData, length); });
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, sinkBase64.Decode(testString, appender));
+			Assert::AreEqual((size_t)0, appended.size());
+		}
+
+		TEST_METHOD(ChecksumsMatchReferenceValues)
+		{
+			uint8_t testData[20000];
+
+			for (size_t i = 0; i < sizeof(testData); i++)
+			{
+				testData[i] = (uint8_t)(i * 131 + 7);
+			}
+
+			Base64Crc32c crc;
+			crc.Update("123456789", 9);
+			Assert::AreEqual((uint32_t)0xE3069283, crc.Digest());
+
+			Assert::AreEqual((uint64_t)0xEF46DB3751D8E999, Base64XxHash64().Digest());
+
+			// Long enough for the interleaved CRC lanes, and updated in uneven pieces
+			Base64Crc32c pieceCrc;
+			Base64XxHash64 pieceHash;
+			Base64XxHash64 seededHash(12345);
+
+			for (size_t offset = 0; offset < sizeof(testData); offset += 777)
+			{
+				size_t length = sizeof(testData) - offset < 777 ? sizeof(testData) - offset : 777;
+
+				pieceCrc.Update(testData + offset, length);
+				pieceHash.Update(testData + offset, length);
+			}
+
+			seededHash.Update(testData, 100);
+
+			Assert::AreEqual((uint32_t)0x2D522EA6, pieceCrc.Digest());
+			Assert::AreEqual((uint64_t)0xD8D16037CEB73C83, pieceHash.Digest());
+			Assert::AreEqual((uint64_t)0x21FC897B6959F33A, seededHash.Digest());
+		}
+
+		TEST_METHOD(EncodeAndDecodeWithChecksumsForEveryKernel)
+		{
+			const size_t testDataLength = 3 * BASE64ENCODING_CHECKSUM_BLOCK_LENGTH + 5;
+
+			uint8_t* testData = new uint8_t[testDataLength];
+			char* encodeBuffer = new char[testDataLength * 2];
+			char* checksumEncodeBuffer = new char[testDataLength * 2];
+			uint8_t* decodeBuffer = new uint8_t[testDataLength];
+
+			for (size_t i = 0; i < testDataLength; i++)
+			{
+				testData[i] = (uint8_t)(i * 29 + (i >> 7));
+			}
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64ChecksumEncoding checksumBase64(base64);
+			Base64EncodingKernel supportedKernel = base64.GetKernel();
+			size_t lengths[] = { 0, 1, 2, BASE64ENCODING_CHECKSUM_BLOCK_LENGTH - 1, BASE64ENCODING_CHECKSUM_BLOCK_LENGTH, BASE64ENCODING_CHECKSUM_BLOCK_LENGTH + 1, testDataLength };
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+				for (size_t length : lengths)
+				{
+					Base64Crc32c expectedCrc;
+					Base64XxHash64 expectedHash;
+					expectedCrc.Update(testData, length);
+					expectedHash.Update(testData, length);
+
+					int64_t encodeLength = base64.Encode(testData, length, encodeBuffer, testDataLength * 2);
+
+					Base64Crc32c encodeCrc;
+					Base64XxHash64 encodeHash;
+					Assert::AreEqual(encodeLength, checksumBase64.Encode(testData, length, checksumEncodeBuffer, testDataLength * 2, encodeCrc, encodeHash));
+					Assert::AreEqual(0, memcmp(encodeBuffer, checksumEncodeBuffer, (size_t)encodeLength));
+					Assert::AreEqual(expectedCrc.Digest(), encodeCrc.Digest());
+					Assert::AreEqual(expectedHash.Digest(), encodeHash.Digest());
+
+					Base64Crc32c decodeCrc;
+					Base64XxHash64 decodeHash;
+					Assert::AreEqual((int64_t)length, checksumBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength, decodeCrc, decodeHash));
+					Assert::AreEqual(0, memcmp(testData, decodeBuffer, length));
+					Assert::AreEqual(expectedCrc.Digest(), decodeCrc.Digest());
+					Assert::AreEqual(expectedHash.Digest(), decodeHash.Digest());
+				}
+
+				Base64Crc32c crc;
+				int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, testDataLength * 2);
+
+				Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, checksumBase64.Encode(testData, testDataLength, checksumEncodeBuffer, (size_t)encodeLength - 1, crc));
+				Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, checksumBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength - 1, crc));
+
+				// A malformed tail after whole blocks is rejected or decoded as Decode decodes it, rather than overflowing an output buffer with room for it
+				size_t blockInputLength = (BASE64ENCODING_CHECKSUM_BLOCK_LENGTH / 3) * 4;
+				char savedTail[3];
+				memcpy(savedTail, encodeBuffer + 2 * blockInputLength, 3);
+
+				for (const char* tail : { "=", "Q=", "QQ=" })
+				{
+					size_t tailLength = strlen(tail);
+					memcpy(encodeBuffer + 2 * blockInputLength, tail, tailLength);
+
+					int64_t expectedLength = base64.Decode(encodeBuffer, 2 * blockInputLength + tailLength, decodeBuffer, testDataLength);
+					int64_t decodeLength = checksumBase64.Decode(encodeBuffer, 2 * blockInputLength + tailLength, decodeBuffer, testDataLength, crc);
+
+					Assert::IsTrue(decodeLength == BASE64ENCODING_INVALID_CHARACTER || decodeLength == expectedLength);
+				}
+
+				memcpy(encodeBuffer + 2 * blockInputLength, savedTail, 3);
+
+				// Padding that ends a block before the final one is in the middle of the string
+				encodeBuffer[blockInputLength - 1] = '=';
+				encodeBuffer[blockInputLength - 2] = '=';
+				Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, checksumBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength, crc));
+
+				encodeBuffer[10] = '*';
+				Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, checksumBase64.Decode(encodeBuffer, (size_t)encodeLength, decodeBuffer, testDataLength, crc));
+			}
+
+			base64.SetKernel(supportedKernel);
+
+			delete[] testData;
+			delete[] encodeBuffer;
+			delete[] checksumEncodeBuffer;
+			delete[] decodeBuffer;
+		}
+
+		TEST_METHOD(EncodeAndDecodeThroughPipelineInUnevenChunks)
+		{
+			const size_t testDataLength = 100001;
+
+			std::vector<uint8_t> testData(testDataLength);
+			std::vector<char> encoded(testDataLength * 2);
+
+			for (size_t i = 0; i < testDataLength; i++)
+			{
+				testData[i] = (uint8_t)(i * 2654435761u >> 24);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				size_t encodeLength = (size_t)base64.Encode(testData.data(), testDataLength, encoded.data(), encoded.size());
+
+				// Chunk lengths that split groups, and a single buffer, which runs the stages in turn
+				size_t layouts[][2] = { { 1000, 3 }, { 4096, 2 }, { 7, 4 }, { 3001, 1 } };
+
+				for (auto& layout : layouts)
+				{
+					Base64PipelineEncoding pipelineBase64(base64, layout[0], layout[1]);
+
+					// Reads return short counts, as pipes and sockets do
+					auto reader = [](const uint8_t* pSource, size_t sourceLength, size_t& position)
+					{
+						return [=, &position](void* pBuffer, size_t length) -> int64_t
+						{
+							size_t readLength = length < 1 + position % 997 ? length : 1 + position % 997;
+
+							readLength = readLength < sourceLength - position ? readLength : sourceLength - position;
+							memcpy(pBuffer, pSource + position, readLength);
+							position += readLength;
+
+							return (int64_t)readLength;
+						};
+					};
+
+					std::string output;
+					auto writer = [&](const void* pData, size_t length)
+					{
+						output.append((const char*)pData, length);
+						return true;
+					};
+
+					size_t position = 0;
+
+					Assert::AreEqual((int64_t)encodeLength, pipelineBase64.Encode(reader(testData.data(), testDataLength, position), writer));
+					Assert::AreEqual(encodeLength, output.size());
+					Assert::AreEqual(0, memcmp(encoded.data(), output.data(), encodeLength));
+
+					output.clear();
+					position = 0;
+
+					Assert::AreEqual((int64_t)testDataLength, pipelineBase64.Decode(reader((const uint8_t*)encoded.data(), encodeLength, position), writer));
+					Assert::AreEqual(testDataLength, output.size());
+					Assert::AreEqual(0, memcmp(testData.data(), output.data(), testDataLength));
+				}
+			}
+
+			// Failures of any stage stop the pipeline
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64PipelineEncoding pipelineBase64(base64, 1000, 3);
+			size_t position = 0;
+
+			auto failingReader = [&](void* pBuffer, size_t length) -> int64_t
+			{
+				if(position >= 5000)
+				{
+					return -1;
+				}
+
+				memset(pBuffer, 'A', length);
+				position += length;
+
+				return (int64_t)length;
+			};
+
+			auto discardingWriter = [](const void*, size_t) { return true; };
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_PIPELINE_ERROR, pipelineBase64.Encode(failingReader, discardingWriter));
+
+			position = 0;
+			Assert::AreEqual((int64_t)BASE64ENCODING_PIPELINE_ERROR, pipelineBase64.Encode([&](void* pBuffer, size_t length) -> int64_t
+			{
+				size_t readLength = position < 20000 ? length : 0;
+				memset(pBuffer, 0, readLength);
+				position += readLength;
+
+				return (int64_t)readLength;
+			},
+			[](const void*, size_t) { return false; }));
+
+			const char* pInvalid = "QUJD*UJD";
+			position = 0;
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, pipelineBase64.Decode([&](void* pBuffer, size_t length) -> int64_t
+			{
+				size_t readLength = 8 - position < length ? 8 - position : length;
+				memcpy(pBuffer, pInvalid + position, readLength);
+				position += readLength;
+
+				return (int64_t)readLength;
+			},
+			discardingWriter));
+		}
+
+		TEST_METHOD(PipelineOverlapsReadingAndWriting)
+		{
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64PipelineEncoding pipelineBase64(base64, 3000, 3);
+
+			std::mutex mutex;
+			std::condition_variable changed;
+			bool reading = false;
+			bool writing = false;
+			bool readingFinished = false;
+			size_t readCount = 0;
+			size_t writeCount = 0;
+			bool readOverlapped = false;
+			bool writeOverlapped = false;
+
+			// Each read after the first waits inside the call for a write to be under way, and each write for a read
+			// Were the stages run in turn, every wait would time out instead
+			auto reader = [&](void* pBuffer, size_t length) -> int64_t
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+
+				if(readCount == 10)
+				{
+					readingFinished = true;
+					changed.notify_all();
+
+					return 0;
+				}
+
+				size_t writeCountOnEntry = writeCount;
+
+				reading = true;
+				changed.notify_all();
+
+				if(readCount++ > 0)
+				{
+					readOverlapped |= changed.wait_for(lock, std::chrono::seconds(5), [&] { return writing || writeCount != writeCountOnEntry; });
+				}
+
+				reading = false;
+				memset(pBuffer, 0x5A, length);
+
+				return (int64_t)length;
+			};
+
+			auto writer = [&](const void*, size_t)
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				size_t readCountOnEntry = readCount;
+
+				writing = true;
+				writeCount++;
+				changed.notify_all();
+
+				changed.wait_for(lock, std::chrono::seconds(5), [&] { return reading || readCount != readCountOnEntry || readingFinished; });
+				writeOverlapped |= reading || readCount != readCountOnEntry;
+
+				writing = false;
+
+				return true;
+			};
+
+			Assert::AreEqual((int64_t)base64.EncodedLength(30000), pipelineBase64.Encode(reader, writer));
+			Assert::IsTrue(readOverlapped);
+			Assert::IsTrue(writeOverlapped);
+		}
+
+#if !defined(_WIN32)
+
+		TEST_METHOD(EncodeAndDecodeThroughPipelineWithPipes)
+		{
+			const size_t testDataLength = 1 << 20;
+
+			std::vector<uint8_t> testData(testDataLength);
+			std::vector<char> encoded(testDataLength * 2);
+
+			for (size_t i = 0; i < testDataLength; i++)
+			{
+				testData[i] = (uint8_t)(i * 2654435761u >> 24);
+			}
+
+			Base64Encoding base64('-', '_', Base64EncodingOptions::Padded);
+			Base64PipelineEncoding pipelineBase64(base64, 65536, 3);
+			size_t encodeLength = (size_t)base64.Encode(testData.data(), testDataLength, encoded.data(), encoded.size());
+
+			// Feeds the input through one pipe and collects the output from another, each on a thread of its own as a producer and consumer would be
+			auto throughPipes = [&](const void* pInput, size_t inputLength, std::string& output, bool decoding)
+			{
+				int inputPipe[2];
+				int outputPipe[2];
+
+				Assert::AreEqual(0, pipe(inputPipe));
+				Assert::AreEqual(0, pipe(outputPipe));
+
+				std::thread producer([&]
+				{
+					Base64DescriptorWriter inputWriter(inputPipe[1]);
+
+					inputWriter(pInput, inputLength);
+					close(inputPipe[1]);
+				});
+
+				std::thread consumer([&]
+				{
+					char buffer[4096];
+					ssize_t readLength;
+
+					while((readLength = read(outputPipe[0], buffer, sizeof(buffer))) > 0)
+					{
+						output.append(buffer, (size_t)readLength);
+					}
+				});
+
+				int64_t result = decoding ? pipelineBase64.Decode(Base64DescriptorReader(inputPipe[0]), Base64DescriptorWriter(outputPipe[1]))
+				                          : pipelineBase64.Encode(Base64DescriptorReader(inputPipe[0]), Base64DescriptorWriter(outputPipe[1]));
+
+				close(outputPipe[1]);
+				producer.join();
+				consumer.join();
+				close(inputPipe[0]);
+				close(outputPipe[0]);
+
+				return result;
+			};
+
+			std::string output;
+
+			Assert::AreEqual((int64_t)encodeLength, throughPipes(testData.data(), testDataLength, output, false));
+			Assert::AreEqual(encodeLength, output.size());
+			Assert::AreEqual(0, memcmp(encoded.data(), output.data(), encodeLength));
+
+			output.clear();
+
+			Assert::AreEqual((int64_t)testDataLength, throughPipes(encoded.data(), encodeLength, output, true));
+			Assert::AreEqual(testDataLength, output.size());
+			Assert::AreEqual(0, memcmp(testData.data(), output.data(), testDataLength));
+		}
+
+		TEST_METHOD(EncodeAndDecodeToIovecSinks)
+		{
+			uint8_t testData[100];
+			char encodeBuffer[200];
+
+			for (size_t i = 0; i < sizeof(testData); i++)
+			{
+				testData[i] = (uint8_t)(i * 91 + 7);
+			}
+
+			for (int padded = 0; padded <= 1; padded++)
+			{
+				Base64Encoding base64('+', '/', padded ? Base64EncodingOptions::Padded : Base64EncodingOptions::Unpadded);
+				Base64SinkEncoding sinkBase64(base64);
+
+				for (size_t testDataLength = 1; testDataLength <= sizeof(testData); testDataLength += 11)
+				{
+					size_t encodedLength = (size_t)base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+					// Buffers of every length up to seven, and some empty, split groups at every position
+					for (size_t segmentLength = 0; segmentLength <= 7; segmentLength++)
+					{
+						char scattered[256];
+						struct iovec vectors[256];
+						size_t vectorCount = 0;
+
+						for (size_t offset = 0; offset < sizeof(scattered); vectorCount++)
+						{
+							size_t length = (segmentLength + vectorCount) % 8;
+							length = offset + length > sizeof(scattered) ? sizeof(scattered) - offset : length;
+							vectors[vectorCount] = { scattered + offset, length };
+							offset += length;
+						}
+
+						Base64IovecSink encodeSink(vectors, vectorCount);
+						Assert::AreEqual((int64_t)encodedLength, sinkBase64.Encode(testData, testDataLength, encodeSink));
+						Assert::AreEqual(encodedLength, encodeSink.Length());
+						Assert::AreEqual(0, memcmp(encodeBuffer, scattered, encodedLength));
+
+						Base64IovecSink decodeSink(vectors, vectorCount);
+						Assert::AreEqual((int64_t)testDataLength, sinkBase64.Decode(std::string_view(encodeBuffer, encodedLength), decodeSink));
+						Assert::AreEqual(0, memcmp(testData, scattered, testDataLength));
+					}
+				}
+			}
+		}
+
+		TEST_METHOD(EncodeAndDecodeFile)
+		{
+			// Large enough to span several windows of a single page
+			const size_t testDataLength = 3 * 4096 * 4 + 5;
+
+			uint8_t* testData = new uint8_t[testDataLength];
+			char* encodeBuffer = new char[testDataLength * 2];
+			char* fileBuffer = new char[testDataLength * 2];
+
+			for (size_t i = 0; i < testDataLength; ++i)
+			{
+				testData[i] = (uint8_t)(i * 2654435761u >> 24);
+			}
+
+			char inputPath[] = "/tmp/Base64EncodingTestsInputXXXXXX";
+			char outputPath[] = "/tmp/Base64EncodingTestsOutputXXXXXX";
+
+			close(mkstemp(inputPath));
+			close(mkstemp(outputPath));
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64ThreadPool threadPool(1);
+				Base64FileEncoding fileBase64(base64, threadPool);
+
+				fileBase64.SetWindowPageCount(1);
+
+				for (size_t length : { (size_t)0, (size_t)1, (size_t)2, (size_t)4095, testDataLength })
+				{
+					int64_t encodeLength = base64.Encode(testData, length, encodeBuffer, testDataLength * 2);
+
+					WriteTestFile(inputPath, testData, length);
+
+					Assert::AreEqual(encodeLength, fileBase64.EncodeFile(inputPath, outputPath));
+					Assert::AreEqual((size_t)encodeLength, ReadTestFile(outputPath, fileBuffer, testDataLength * 2));
+					Assert::AreEqual(0, memcmp(encodeBuffer, fileBuffer, (size_t)encodeLength));
+
+					// A trailing line break, as most tools write, is ignored
+					memcpy(encodeBuffer + encodeLength, "\r\n", 2);
+					WriteTestFile(inputPath, encodeBuffer, (size_t)encodeLength + 2);
+
+					Assert::AreEqual((int64_t)length, fileBase64.DecodeFile(inputPath, outputPath));
+					Assert::AreEqual(length, ReadTestFile(outputPath, fileBuffer, testDataLength * 2));
+					Assert::AreEqual(0, memcmp(testData, fileBuffer, length));
+				}
+
+				// Rejected input leaves the output file empty, wherever the invalid character falls
+				int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, testDataLength * 2);
+
+				for (size_t position : { (size_t)3, (size_t)4 * 4096 - 1, (size_t)encodeLength - 6 })
+				{
+					char character = encodeBuffer[position];
+
+					encodeBuffer[position] = position == 4 * 4096 - 1 ? '=' : '*';
+					WriteTestFile(inputPath, encodeBuffer, (size_t)encodeLength);
+					encodeBuffer[position] = character;
+
+					Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, fileBase64.DecodeFile(inputPath, outputPath));
+					Assert::AreEqual((size_t)0, ReadTestFile(outputPath, fileBuffer, testDataLength * 2));
+				}
+
+				// Text whose length leaves characters that would be dropped, or holding only padding, is rejected rather than partly decoded
+				for (const char* testString : { "*", "A", "====", "A\n", "AAAAA", "YWJj=", "YWJjYQ=" })
+				{
+					WriteTestFile(inputPath, testString, strlen(testString));
+
+					Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, fileBase64.DecodeFile(inputPath, outputPath));
+					Assert::AreEqual((size_t)0, ReadTestFile(outputPath, fileBuffer, testDataLength * 2));
+				}
+			}
+
+			unlink(inputPath);
+			unlink(outputPath);
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64FileEncoding fileBase64(base64);
+
+			Assert::AreEqual((int64_t)BASE64ENCODING_FILE_ERROR, fileBase64.EncodeFile(inputPath, outputPath));
+			Assert::AreEqual((int64_t)BASE64ENCODING_FILE_ERROR, fileBase64.DecodeFile(inputPath, outputPath));
+
+			delete[] fileBuffer;
+			delete[] encodeBuffer;
+			delete[] testData;
+		}
+
+#endif
+
+		TEST_METHOD(DecodeIgnoringWhitespaceForEveryKernel)
+		{
+			uint8_t testData[2000];
+			char encodeBuffer[2700];
+			char wrappedBuffer[4000];
+			uint32_t seed = 97531;
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				testData[i] = (uint8_t)(seed >> 16);
+			}
+
+			struct
+			{
+				size_t LineLength;
+				const char* LineBreak;
+			}
+			layouts[] = { { 64, "\r\n" }, { 76, "\r\n" }, { 64, "\n" }, { 20, "\n" }, { 128, "\n" }, { 30, "\n" }, { 7, " \t" } };
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 97)
+				{
+					int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+					for (auto& layout : layouts)
+					{
+						size_t wrappedLength = WrapLines(encodeBuffer, (size_t)encodeLength, layout.LineLength, layout.LineBreak, wrappedBuffer);
+
+						Assert::IsTrue(base64.DecodedLengthUpperBound(wrappedLength) >= testDataLength);
+
+						for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+						{
+							Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+							// The output buffer is sized exactly, so any store beyond the decoded data would be caught
+							uint8_t* decodeBuffer = new uint8_t[testDataLength + 1];
+
+							int64_t decodeLength = base64.DecodeIgnoringWhitespace(wrappedBuffer, wrappedLength, decodeBuffer, testDataLength);
+
+							Assert::AreEqual((int64_t)testDataLength, decodeLength);
+							Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+
+							delete[] decodeBuffer;
+						}
+					}
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(DecodeIgnoringWhitespaceInsideLines)
+		{
+			uint8_t testData[3000];
+			char encodeBuffer[4000];
+			char wrappedBuffer[4200];
+			uint8_t decodeBuffer[3000];
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				testData[i] = (uint8_t)(i * 7 + 3);
+			}
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64EncodingKernel supportedKernel = base64.GetKernel();
+			int64_t encodeLength = base64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer));
+
+			// Lines after the first ten hold 63 characters and a space, so they match the line layout but cannot be decoded straight from the input
+			size_t wrappedLength = 0;
+
+			for (size_t i = 0, line = 0; i < (size_t)encodeLength; line++)
+			{
+				size_t lineLength = line < 10 ? 64 : 63;
+				size_t length = (size_t)encodeLength - i < lineLength ? (size_t)encodeLength - i : lineLength;
+
+				memcpy(wrappedBuffer + wrappedLength, encodeBuffer + i, length);
+				wrappedLength += length;
+				i += length;
+
+				if(line >= 10)
+				{
+					wrappedBuffer[wrappedLength++] = ' ';
+				}
+
+				wrappedBuffer[wrappedLength++] = '\r';
+				wrappedBuffer[wrappedLength++] = '\n';
+			}
+
+			for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+			{
+				Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+				int64_t decodeLength = base64.DecodeIgnoringWhitespace(wrappedBuffer, wrappedLength, decodeBuffer, sizeof(decodeBuffer));
+
+				Assert::AreEqual((int64_t)sizeof(testData), decodeLength);
+				Assert::AreEqual(0, memcmp(testData, decodeBuffer, sizeof(testData)));
+			}
+
+			base64.SetKernel(supportedKernel);
+		}
+
+		TEST_METHOD(DecodeIgnoringWhitespaceRejectsInvalidInput)
+		{
+			uint8_t decodeBuffer[64];
+			const char* testString;
+
+			// Padding may itself be broken by whitespace
+			testString = " YWJj\r\nZA=\n= \n";
+			Assert::AreEqual((int64_t)4, Base64StandardCodec::DecodeIgnoringWhitespace(testString, strlen(testString), decodeBuffer, sizeof(decodeBuffer)));
+			Assert::AreEqual(0, memcmp("abcd", decodeBuffer, 4));
+
+			testString = "YWJj\nZ*==\n";
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::DecodeIgnoringWhitespace(testString, strlen(testString), decodeBuffer, sizeof(decodeBuffer)));
+
+			testString = "YQ==\nYWJj\n";
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::DecodeIgnoringWhitespace(testString, strlen(testString), decodeBuffer, sizeof(decodeBuffer)));
+
+			// The fast path checks the output buffer before decoding a line
+			testString = "YWJj\nYWJj\n";
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, Base64StandardCodec::DecodeIgnoringWhitespace(testString, strlen(testString), decodeBuffer, 5));
+		}
+
+		TEST_METHOD(DecodeDelimitedJsonFieldsForEveryKernel)
+		{
+			uint8_t testData[1500];
+			char encodeBuffer[2100];
+			char documentBuffer[4300];
+
+			for (size_t i = 0; i < sizeof(testData); ++i)
+			{
+				testData[i] = (uint8_t)(i * 29 + 11);
+			}
+
+			Base64EncodingOptions options[] = { Base64EncodingOptions::Unpadded, Base64EncodingOptions::Padded };
+
+			for (Base64EncodingOptions option : options)
+			{
+				Base64Encoding base64('+', '/', option);
+				Base64EncodingKernel supportedKernel = base64.GetKernel();
+
+				for (size_t testDataLength = 0; testDataLength <= sizeof(testData); testDataLength += 61)
+				{
+					int64_t encodeLength = base64.Encode(testData, testDataLength, encodeBuffer, sizeof(encodeBuffer));
+
+					// Every '/' is escaped, as some JSON encoders do, and the field is followed by more of the document
+					for (int escaped = 0; escaped <= 1; ++escaped)
+					{
+						size_t documentLength = (size_t)sprintf(documentBuffer, "{\"data\":\"");
+						size_t fieldOffset = documentLength;
+
+						for (size_t i = 0; i < (size_t)encodeLength; ++i)
+						{
+							if (escaped && encodeBuffer[i] == '/')
+							{
+								documentBuffer[documentLength++] = '\\';
+							}
+
+							documentBuffer[documentLength++] = encodeBuffer[i];
+						}
+
+						size_t closingOffset = documentLength;
+						documentLength += (size_t)sprintf(documentBuffer + documentLength, "\",\"next\":1}");
+
+						for (int kernel = Base64EncodingKernel::Base64KernelScalar; kernel <= supportedKernel; ++kernel)
+						{
+							Assert::IsTrue(base64.SetKernel((Base64EncodingKernel)kernel));
+
+							// The output buffer is sized exactly, so any store beyond the decoded data would be caught
+							uint8_t* decodeBuffer = new uint8_t[testDataLength + 1];
+							size_t consumedLength = 0;
+
+							int64_t decodeLength = base64.DecodeDelimited(documentBuffer + fieldOffset, documentLength - fieldOffset, '"', decodeBuffer, testDataLength, consumedLength);
+
+							Assert::AreEqual((int64_t)testDataLength, decodeLength);
+							Assert::AreEqual(0, memcmp(testData, decodeBuffer, testDataLength));
+							Assert::AreEqual(closingOffset + 1 - fieldOffset, consumedLength);
+
+							delete[] decodeBuffer;
+						}
+					}
+				}
+
+				base64.SetKernel(supportedKernel);
+			}
+		}
+
+		TEST_METHOD(DecodeDelimitedEdgeCases)
+		{
+			uint8_t decodeBuffer[64];
+			size_t consumedLength = 0;
+			const char* testString;
+
+			// Without a terminator the whole buffer is the string
+			testString = "YWJjZA==";
+			Assert::AreEqual((int64_t)4, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+			Assert::AreEqual(0, memcmp("abcd", decodeBuffer, 4));
+			Assert::AreEqual((size_t)8, consumedLength);
+
+			testString = "\"}";
+			Assert::AreEqual((int64_t)0, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+			Assert::AreEqual((size_t)1, consumedLength);
+
+			// Escapes may split groups anywhere, including the final padded one
+			testString = "\\/\\/\\/\\/P\\/8=\"";
+			Assert::AreEqual((int64_t)5, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+			Assert::AreEqual(0, memcmp("\xFF\xFF\xFF\x3F\xFF", decodeBuffer, 5));
+			Assert::AreEqual(strlen(testString), consumedLength);
+
+			testString = "YWJj\\/w\"";
+			Assert::AreEqual((int64_t)4, Base64UrlSafeUnpaddedCodec::DecodeDelimited("YWJj_w\"", 7, '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64UrlSafeUnpaddedCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+
+			// Any other escape, or padding before the end of the string, is rejected
+			consumedLength = 0;
+
+			testString = "YWJj\\nZA==\"";
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+
+			testString = "YWJj\\";
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+
+			testString = "YQ==\\/w==\"";
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, sizeof(decodeBuffer), consumedLength));
+			Assert::AreEqual((size_t)0, consumedLength);
+
+			testString = "YWJjYWJj\\/w==\"";
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, Base64StandardCodec::DecodeDelimited(testString, strlen(testString), '"', decodeBuffer, 5, consumedLength));
+		}
+
+#ifdef BASE64ENCODING_INSTRUMENTATION
+
+		TEST_METHOD(InstrumentationCountsCalls)
+		{
+			uint8_t testData[100] = {};
+			char encodeBuffer[200];
+			uint8_t decodeBuffer[100];
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+			Base64EncodingKernel kernel = base64.GetKernel();
+
+			Base64Metrics::Reset();
+
+			Assert::AreEqual((int64_t)136, base64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer)));
+			Assert::AreEqual((int64_t)BASE64ENCODING_BUFFER_OVERFLOW, base64.Encode(testData, sizeof(testData), encodeBuffer, 10));
+			Assert::AreEqual((int64_t)100, base64.Decode(encodeBuffer, 136, decodeBuffer, sizeof(decodeBuffer)));
+			Assert::IsTrue(base64.DecodeStrict("QR==", 4, decodeBuffer, sizeof(decodeBuffer)).Status == Base64DecodeStatus::Base64DecodeNonCanonicalTrailingBits);
+			Assert::AreEqual((int64_t)BASE64ENCODING_INVALID_CHARACTER, base64.Decode("QQ*=", 4, decodeBuffer, sizeof(decodeBuffer)));
+
+			Base64MetricsSnapshot snapshot = Base64Metrics::Snapshot();
+			const Base64OperationMetrics& encodeMetrics = snapshot.Operations[Base64MetricsOperation::Base64MetricsEncoding][kernel];
+			const Base64OperationMetrics& decodeMetrics = snapshot.Operations[Base64MetricsOperation::Base64MetricsDecoding][kernel];
+
+			Assert::AreEqual((uint64_t)2, encodeMetrics.Calls);
+			Assert::AreEqual((uint64_t)200, encodeMetrics.InputBytes);
+			Assert::AreEqual((uint64_t)136, encodeMetrics.OutputBytes);
+			Assert::AreEqual((uint64_t)1, encodeMetrics.BufferOverflows);
+
+			// 100 bytes fall in the bucket of lengths from 64 to 127
+			Assert::AreEqual((uint64_t)2, encodeMetrics.SizeHistogram[7]);
+
+			Assert::AreEqual((uint64_t)3, decodeMetrics.Calls);
+			Assert::AreEqual((uint64_t)144, decodeMetrics.InputBytes);
+			Assert::AreEqual((uint64_t)100, decodeMetrics.OutputBytes);
+			Assert::AreEqual((uint64_t)2, decodeMetrics.InvalidInputs);
+			Assert::AreEqual((uint64_t)1, decodeMetrics.SizeHistogram[8]);
+			Assert::AreEqual((uint64_t)2, decodeMetrics.SizeHistogram[3]);
+			Assert::IsTrue(encodeMetrics.TimedCalls + decodeMetrics.TimedCalls <= 1);
+
+			// The counts of exited threads are kept
+			std::thread thread([&]
+			{
+				Base64Encoding threadBase64('+', '/', Base64EncodingOptions::Padded);
+				threadBase64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer));
+			});
+
+			thread.join();
+
+			snapshot = Base64Metrics::Snapshot();
+			Assert::AreEqual((uint64_t)3, snapshot.Operations[Base64MetricsOperation::Base64MetricsEncoding][kernel].Calls);
+
+			SummingExporter exporter;
+			Base64Metrics::Export(exporter);
+			Assert::AreEqual((uint64_t)6, exporter.Calls);
+			Assert::AreEqual((uint64_t)2, exporter.InvalidInputs);
+			Assert::AreEqual((uint64_t)6, exporter.HistogramTotal);
+
+			// One call in every BASE64ENCODING_METRICS_TIMING_INTERVAL is timed
+			Base64Metrics::Reset();
+
+			for (size_t i = 0; i < BASE64ENCODING_METRICS_TIMING_INTERVAL; i++)
+			{
+				base64.Encode(testData, sizeof(testData), encodeBuffer, sizeof(encodeBuffer));
+			}
+
+			snapshot = Base64Metrics::Snapshot();
+			Assert::AreEqual((uint64_t)1, snapshot.Operations[Base64MetricsOperation::Base64MetricsEncoding][kernel].TimedCalls);
+			Assert::AreEqual((uint64_t)100, snapshot.Operations[Base64MetricsOperation::Base64MetricsEncoding][kernel].TimedInputBytes);
+			Assert::IsTrue(snapshot.Operations[Base64MetricsOperation::Base64MetricsEncoding][kernel].CyclesPerByte() > 0);
+
+			Base64Metrics::Reset();
+			Assert::AreEqual((uint64_t)0, Base64Metrics::Snapshot().Operations[Base64MetricsOperation::Base64MetricsEncoding][kernel].Calls);
+		}
+
+		TEST_METHOD(InstrumentationCallsTraceHook)
+		{
+			uint8_t decodeBuffer[16];
+			Base64BatchItem items[] = { { "AQID", 4 }, { "BAU=", 4 } };
+			size_t offsets[3];
+
+			Base64Encoding base64('+', '/', Base64EncodingOptions::Padded);
+
+			TracedCallCount = 0;
+			Base64Metrics::SetTraceHook(TraceCall);
+
+			// A batch is traced as a single call
+			Assert::AreEqual((int64_t)5, base64.DecodeBatch(items, 2, decodeBuffer, sizeof(decodeBuffer), offsets));
+			Assert::AreEqual((size_t)1, TracedCallCount);
+			Assert::AreEqual((int64_t)5, TracedResult);
+
+			Base64Metrics::SetTraceHook(NULL);
+
+			base64.DecodeBatch(items, 2, decodeBuffer, sizeof(decodeBuffer), offsets);
+			Assert::AreEqual((size_t)1, TracedCallCount);
+		}
+
+#endif
 	};
 }
@@ -0,0 +1,168 @@
+#ifndef CppUnitTest_h
+#define CppUnitTest_h
+
+// Minimal portable stand-in for the subset of the Microsoft CppUnitTest framework used by the tests
+// Allows the MSVC test sources to be compiled and run unmodified on other toolchains
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+namespace VisualStudio
+{
+namespace CppUnitTestFramework
+{
+    struct TestFailure : public std::runtime_error
+    {
+        TestFailure(const std::string& message)
+          : std::runtime_error(message)
+        {
+
+        }
+    };
+
+    struct TestRegistration
+    {
+        const char* ClassName;
+        const char* MethodName;
+        std::function<void()> Method;
+    };
+
+    inline std::vector<TestRegistration>& RegisteredTests()
+    {
+        static std::vector<TestRegistration> tests;
+        return tests;
+    }
+
+    struct TestRegistrar
+    {
+        TestRegistrar(const char* className, const char* methodName, void (*method)())
+        {
+            RegisteredTests().push_back({ className, methodName, method });
+        }
+    };
+
+    template<typename T, typename TName>
+    class TestClass
+    {
+        protected:
+
+            typedef T TestClassType;
+            typedef TName TestClassNameType;
+    };
+
+    // Runs every registered test method and returns the number of failures
+    inline int RunAllTests()
+    {
+        int failures = 0;
+
+        for(const TestRegistration& test : RegisteredTests())
+        {
+            try
+            {
+                test.Method();
+                printf("[  PASSED  ] %s::%s\n", test.ClassName, test.MethodName);
+            }
+            catch(const std::exception& exception)
+            {
+                printf("[  FAILED  ] %s::%s: %s\n", test.ClassName, test.MethodName, exception.what());
+                failures++;
+            }
+        }
+
+        printf("%d of %d tests passed\n", (int)RegisteredTests().size() - failures, (int)RegisteredTests().size());
+
+        return failures;
+    }
+
+    class Assert
+    {
+        private:
+
+            template<typename T>
+            static std::string Describe(const T& value)
+            {
+                std::ostringstream stream;
+                stream << +value;
+                return stream.str();
+            }
+
+            static void Fail(const std::string& message)
+            {
+                throw TestFailure(message);
+            }
+
+        public:
+
+            template<typename T>
+            static void AreEqual(const T& expected, const T& actual)
+            {
+                if(!(expected == actual))
+                {
+                    Fail("Assert::AreEqual failed. Expected <" + Describe(expected) + "> Actual <" + Describe(actual) + ">");
+                }
+            }
+
+            static void AreEqual(const char* expected, const char* actual)
+            {
+                if(strcmp(expected, actual) != 0)
+                {
+                    Fail(std::string("Assert::AreEqual failed. Expected <") + expected + "> Actual <" + actual + ">");
+                }
+            }
+
+            template<typename T>
+            static void AreNotEqual(const T& notExpected, const T& actual)
+            {
+                if(notExpected == actual)
+                {
+                    Fail("Assert::AreNotEqual failed. Value <" + Describe(actual) + ">");
+                }
+            }
+
+            static void IsTrue(bool condition)
+            {
+                if(!condition)
+                {
+                    Fail("Assert::IsTrue failed");
+                }
+            }
+
+            static void IsFalse(bool condition)
+            {
+                if(condition)
+                {
+                    Fail("Assert::IsFalse failed");
+                }
+            }
+    };
+}
+}
+}
+
+#define TEST_CLASS(className) \
+    struct className##Name \
+    { \
+        static const char* Get() \
+        { \
+            return #className; \
+        } \
+    }; \
+    class className : public Microsoft::VisualStudio::CppUnitTestFramework::TestClass<className, className##Name>
+
+#define TEST_METHOD(methodName) \
+    static void methodName##Invoke() \
+    { \
+        TestClassType().methodName(); \
+    } \
+    inline static const Microsoft::VisualStudio::CppUnitTestFramework::TestRegistrar methodName##Registrar{ TestClassNameType::Get(), #methodName, &methodName##Invoke }; \
+    void methodName()
+
+#endif // CppUnitTest_h
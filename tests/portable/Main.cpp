@@ -0,0 +1,8 @@
+// Entry point for the portable test runner, the MSVC test adapter provides its own
+
+#include "CppUnitTest.h"
+
+int main()
+{
+    return Microsoft::VisualStudio::CppUnitTestFramework::RunAllTests() == 0 ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+// Encodes or decodes a file through memory mappings, splitting the work across every hardware thread
+// The output is written without line breaks, and trailing line breaks in decoded input are ignored
+// Usage: base64 [-d] [-u] [--url] [--threads count] input output
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/Base64EncodingFile.hpp"
+
+void PrintUsage(const char* pProgram)
+{
+    fprintf(stderr, "Usage: %s [-d] [-u] [--url] [--threads count] input output\n", pProgram);
+    fprintf(stderr, "  -d         decode instead of encode\n");
+    fprintf(stderr, "  -u         omit padding when encoding, and expect none when decoding\n");
+    fprintf(stderr, "  --url      use the URL and filename safe alphabet\n");
+    fprintf(stderr, "  --threads  number of threads, every hardware thread by default\n");
+}
+
+int main(int argc, char** argv)
+{
+    bool decoding = false;
+    bool padded = true;
+    bool urlSafe = false;
+    size_t threadCount = 0;
+    const char* pInputPath = NULL;
+    const char* pOutputPath = NULL;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-d") == 0)
+        {
+            decoding = true;
+        }
+        else if(strcmp(argv[i], "-u") == 0)
+        {
+            padded = false;
+        }
+        else if(strcmp(argv[i], "--url") == 0)
+        {
+            urlSafe = true;
+        }
+        else if(strcmp(argv[i], "--threads") == 0)
+        {
+            // The count is required, so a bare --threads is neither taken as a path nor allowed to take the next path as its count
+            char* pEnd = NULL;
+
+            if(i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9')
+            {
+                threadCount = (size_t)strtoull(argv[++i], &pEnd, 10);
+            }
+
+            if(pEnd == NULL || *pEnd != '\0')
+            {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        }
+        else if(pInputPath == NULL)
+        {
+            pInputPath = argv[i];
+        }
+        else if(pOutputPath == NULL)
+        {
+            pOutputPath = argv[i];
+        }
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(pInputPath == NULL || pOutputPath == NULL)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    Base64Encoding base64(urlSafe ? '-' : '+', urlSafe ? '_' : '/', padded ? Base64EncodingOptions::Padded : Base64EncodingOptions::Unpadded);
+
+    // The thread calling into the pool also takes part, so it needs one worker fewer than the thread count
+    if(threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1;
+    }
+
+    Base64ThreadPool threadPool(threadCount - 1);
+    Base64FileEncoding fileBase64(base64, threadPool);
+
+    int64_t result = decoding ? fileBase64.DecodeFile(pInputPath, pOutputPath) : fileBase64.EncodeFile(pInputPath, pOutputPath);
+
+    if(result == BASE64ENCODING_FILE_ERROR)
+    {
+        fprintf(stderr, "%s: %s\n", argv[0], strerror(errno));
+        return 1;
+    }
+
+    if(result == BASE64ENCODING_INVALID_CHARACTER)
+    {
+        fprintf(stderr, "%s: %s is not valid Base64\n", argv[0], pInputPath);
+        return 1;
+    }
+
+    return 0;
+}